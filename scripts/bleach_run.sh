@@ -3,6 +3,10 @@ if [ $# -eq 0 ]; then
     # No arguments provided, start the REPL
     echo -e "${GREEN}Starting the Bleach REPL... ${NC}"
     ../src/BleachInterpreter
+elif [ "$1" = "--batch" ]; then
+    # Batch mode: run every given Bleach file (or manifest) in a single process
+    echo -e "${GREEN}Executing the Bleach files in batch mode... ${NC}"
+    ../src/BleachInterpreter "$@"
 else
     # Argument provided, execute the specified Bleach file
     echo -e "${GREEN}Executing the Bleach file (.bch): '$1' ${NC}"
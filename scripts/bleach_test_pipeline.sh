@@ -5,6 +5,8 @@ VALID_BLEACH_PROGRAMS_DIR="../tests/valid_bleach_programs"
 INVALID_BLEACH_PROGRAMS_DIR="../tests/invalid_bleach_programs"
 EXPECTED_VALID_BLEACH_PROGRAMS_OUTPUT_DIR="../tests/valid_bleach_programs_output"
 EXPECTED_INVALID_BLEACH_PROGRAMS_OUTPUT_DIR="../tests/invalid_bleach_programs_output"
+SERVER_BLEACH_PROGRAMS_DIR="../tests/server_bleach_programs"
+EXPECTED_SERVER_BLEACH_PROGRAMS_OUTPUT_DIR="../tests/server_bleach_programs_output"
 
 # Path to the Bleach Interpreter executable
 BLEACH_BUILD="./bleach_build.sh"
@@ -26,17 +28,27 @@ total_valid=0
 passed_valid=0
 total_invalid=0
 passed_invalid=0
+total_server=0
+passed_server=0
 
 $BLEACH_BUILD
+make -C ../src modules > /dev/null # Native modules imported by the test suite
 
 # Function to run a single invalid test
 run_invalid_test() {
-    local file=$1
-    local log_file="$LOG_DIR/$(basename "$file").log"
+    local file=$1 # file to be executed
+    local log_file=$2 # file with the produced result (including the errors) by the executed file
+    local expected_result_file=$3 # file with the expected result to be generated by the executed file
 
     printf "${YELLOW}Running invalid test: $file...${NC}\n"
-    if $INTERPRETER "$file" >"$log_file" 2>&1; then
+    $INTERPRETER "$file" >"$log_file" 2>&1
+    local status=$?
+    if [ $status -eq 0 ]; then
         printf "${RED}Invalid test passed (unexpected success): $file${NC}\n"
+    elif [ $status -gt 128 ]; then
+        printf "${RED}Invalid test failed (interpreter crash): $file${NC}\n"
+    elif ! diff -q "$log_file" "$expected_result_file" > /dev/null; then
+        printf "${RED}Invalid test failed (output mismatch): $file${NC}\n"
     else
         printf "${GREEN}Invalid test failed (as expected): $file${NC}\n"
         ((passed_invalid++))
@@ -64,6 +76,47 @@ run_valid_test() {
     ((total_valid++))
 }
 
+# Function to send a "FILE <path>" request to the server listening on a Unix domain socket (prints the exit status of the program)
+send_server_request() {
+    local socket=$1 # path of the socket of the server
+    local file=$2 # file to be run by the server
+
+    python3 - "$socket" "$(realpath "$file")" <<'EOF'
+import socket, sys
+client = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+client.connect(sys.argv[1])
+client.sendall(("FILE " + sys.argv[2] + "\n").encode())
+response = b""
+while chunk := client.recv(65536):
+    response += chunk
+print(response.decode(errors="replace").rsplit("EXIT ", 1)[-1].split()[0])
+EOF
+}
+
+# Function to run a single server test: The file is run twice by the server (the second run reuses the compiled
+# program) and, then, the snapshot it takes is restored on top of the file of the same name inside "restore"
+run_server_test() {
+    local socket=$1 # path of the socket of the server
+    local file=$2 # file to be run by the server
+    local log_file=$3 # file with the produced result by the restored file
+    local expected_result_file=$4 # file with the expected result to be generated by the restored file
+    local snapshot_file="$LOG_DIR/server_bleach_programs/$(basename "$file" .bch).snap"
+
+    printf "${YELLOW}Running server test: $file${NC}\n"
+    rm -f "$snapshot_file"
+    if [ "$(send_server_request "$socket" "$file")" != "0" ] || [ "$(send_server_request "$socket" "$file")" != "0" ]; then
+        printf "${RED}Server test failed (server error): $file${NC}\n"
+    elif ! $INTERPRETER --restore "$snapshot_file" "$(dirname "$file")/restore/$(basename "$file")" > "$log_file" 2>&1; then
+        printf "${RED}Server test failed (restore error): $file${NC}\n"
+    elif ! diff -q "$log_file" "$expected_result_file" > /dev/null; then
+        printf "${RED}Server test failed (output mismatch): $file${NC}\n"
+    else
+        printf "${GREEN}Server test passed: $file${NC}\n"
+        ((passed_server++))
+    fi
+    ((total_server++))
+}
+
 # Run tests for valid Bleach files
 for subdir in "expressions" "native_functions" "statements"; do
     for file in "$VALID_BLEACH_PROGRAMS_DIR/$subdir"/*.bch; do
@@ -71,9 +124,40 @@ for subdir in "expressions" "native_functions" "statements"; do
     done
 done
 
+# Run tests for invalid Bleach files (programs that must stop with an error, without crashing the interpreter)
+for subdir in "runtime_errors"; do
+    mkdir -p "$LOG_DIR/invalid_bleach_programs/$subdir"
+    for file in "$INVALID_BLEACH_PROGRAMS_DIR/$subdir"/*.bch; do
+        run_invalid_test "$file" "$LOG_DIR/invalid_bleach_programs/$subdir/$(basename "$file").log" "$EXPECTED_INVALID_BLEACH_PROGRAMS_OUTPUT_DIR/$subdir/$(basename "$file").expected"
+    done
+done
+
+# Run tests for Bleach files run by the "Server Mode" of the interpreter
+mkdir -p "$LOG_DIR/server_bleach_programs"
+SERVER_SOCKET="$LOG_DIR/server_bleach_programs/bleach.sock"
+rm -f "$SERVER_SOCKET"
+$INTERPRETER --serve "$SERVER_SOCKET" > /dev/null 2>&1 &
+SERVER_PID=$!
+for _ in $(seq 50); do
+    [ -S "$SERVER_SOCKET" ] && break
+    sleep 0.1
+done
+for file in "$SERVER_BLEACH_PROGRAMS_DIR"/*.bch; do
+    run_server_test "$SERVER_SOCKET" "$file" "$LOG_DIR/server_bleach_programs/$(basename "$file").log" "$EXPECTED_SERVER_BLEACH_PROGRAMS_OUTPUT_DIR/$(basename "$file").expected"
+done
+kill "$SERVER_PID" 2> /dev/null
+wait "$SERVER_PID" 2> /dev/null
+rm -f "$SERVER_SOCKET"
+
 # Show summaries
 echo ""
 printf "${BLUE}Bleach Test Suite Execution Summary${NC}\n"
 printf "${BLUE}Total valid tests: $total_valid${NC}\n"
 printf "${GREEN}Passed valid tests: $passed_valid${NC}\n"
 printf "${RED}Failed valid tests: $((total_valid - passed_valid))${NC}\n"
+printf "${BLUE}Total invalid tests: $total_invalid${NC}\n"
+printf "${GREEN}Passed invalid tests: $passed_invalid${NC}\n"
+printf "${RED}Failed invalid tests: $((total_invalid - passed_invalid))${NC}\n"
+printf "${BLUE}Total server tests: $total_server${NC}\n"
+printf "${GREEN}Passed server tests: $passed_server${NC}\n"
+printf "${RED}Failed server tests: $((total_server - passed_server))${NC}\n"
@@ -4,14 +4,15 @@
 #include <string_view>
 
 #include "./BleachRuntimeError.hpp"
+#include "../utils/Streams.hpp"
 #include "../utils/Token.hpp"
 
 
 const std::string RED = "\033[31m"; /**< Constant that allows the BLEACH Interpreter to display red colored error messages. */
 const std::string WHITE = "\033[37m"; /**< Constant that allows the BLEACH Interpreter to reset the terminal output color back to white after displaying an error message. */
 
-inline bool hadError = false; /**< Variable that ensures that the BLEACH Interpreter will not execute code if there's a syntax error in the source code. */
-inline bool hadRuntimeError = false; /**< Variable that signals that the BLEACH Interpreter threw a runtime error when executing the source code. */
+inline thread_local bool hadError = false; /**< Variable that ensures that the BLEACH Interpreter will not execute code if there's a syntax error in the source code. It's thread local, so Bleach programs run by different threads (in the "--batch" mode) do not interfere with each other. */
+inline thread_local bool hadRuntimeError = false; /**< Variable that signals that the BLEACH Interpreter threw a runtime error when executing the source code. It's thread local for the same reason. */
 
 /**
  * @brief Reports the occcurrence of a syntax error to the user through the standard error stream (usually is 
@@ -26,9 +27,9 @@ inline bool hadRuntimeError = false; /**< Variable that signals that the BLEACH
 **/
 static void report(int errorLine, std::string_view errorLocation, std::string_view errorMessage){
   if(errorLocation.length() != 0){
-    std::cerr << RED << "[BLEACH Interpreter Error]: " << "Static Error occurred at Line: " << errorLine << " - Error happened at location " << errorLocation << " - Error Message: " << errorMessage << "." << WHITE << std::endl;
+    *errorStream << RED << "[BLEACH Interpreter Error]: " << "Static Error occurred at Line: " << errorLine << " - Error happened at location " << errorLocation << " - Error Message: " << errorMessage << "." << WHITE << std::endl;
   }else{
-    std::cerr << RED << "[BLEACH Interpreter Error]: " << "Static Error occurred at Line: " << errorLine << " - Error Message: " << errorMessage << "." << WHITE << std::endl;
+    *errorStream << RED << "[BLEACH Interpreter Error]: " << "Static Error occurred at Line: " << errorLine << " - Error Message: " << errorMessage << "." << WHITE << std::endl;
   }
   hadError = true;
 
@@ -79,7 +80,7 @@ static void error(const Token& token, std::string_view errorMessage){
  * @return Nothing (void).
 **/
 static void runtimeError(const BleachRuntimeError& error){
-  std::cerr << RED << "[BLEACH Interpreter Error]: Runtime Error occured at Line " << error.token.line << ". - Error happened at location: " << error.token.lexeme << ". - Error Message: " << error.what() << WHITE << std::endl;
+  *errorStream << RED << "[BLEACH Interpreter Error]: Runtime Error occured at Line " << error.token.line << ". - Error happened at location: " << error.token.lexeme << ". - Error Message: " << error.what() << WHITE << std::endl;
   hadRuntimeError = true;
 
   return;
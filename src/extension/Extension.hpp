@@ -0,0 +1,54 @@
+#pragma once
+
+#include <memory>
+
+#include "../utils/NativeBinding.hpp"
+
+
+/**
+ * @brief Version of the interface between the interpreter and its native modules. A native module is only
+ * loaded if it has been compiled against the same version of this header (see the BLEACH_EXTENSION macro).
+**/
+#define BLEACH_EXTENSION_VERSION 1
+
+/**
+ * @class BleachRegistrar
+ *
+ * @brief Interface through which a native module registers its native functions when it's loaded by an
+ * "import native" statement.
+ *
+ * The names of such native functions must be namespaced (e.g. "vec::dot"), and the "std" namespace is reserved
+ * to the standard library. A native class is registered as a native function (its constructor) that returns a
+ * "std::shared_ptr<BleachNativeObject>", whose "getProperty" method provides the methods of the class.
+**/
+class BleachRegistrar{
+  public:
+    virtual ~BleachRegistrar() = default;
+
+    /**
+     * @brief Defines a native function inside the global environment, under its own name.
+     *
+     * @param native: The native function (usually generated by the "bindNative" function).
+     *
+     * @note: If the name of the native function is not valid or is already in use, then an instance of the
+     * std::runtime_error class is thrown.
+    **/
+    virtual void defineNative(std::shared_ptr<BleachNativeFunction> native) = 0;
+};
+
+/**
+ * @brief Declares the entry points of a native module. It must be followed by the body of the function that
+ * registers the native functions of the module. For example:
+ *
+ * BLEACH_EXTENSION(registrar){
+ *   registrar.defineNative(bindNative<double(double, double)>("vec::hypot", [](double x, double y){ ... }));
+ * }
+ *
+ * A native module is a shared library compiled from such file with the same compiler and standard library as
+ * the interpreter (e.g. "g++ -std=c++17 -shared -fPIC -I <path to src> module.cpp -o libmodule.so").
+**/
+#define BLEACH_EXTENSION(registrar) \
+  extern "C" int bleachExtensionVersion(){ \
+    return BLEACH_EXTENSION_VERSION; \
+  } \
+  extern "C" void bleachExtensionInit(BleachRegistrar& registrar)
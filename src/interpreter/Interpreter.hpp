@@ -1,16 +1,23 @@
 #pragma once
 
 #include <any>
+#include <chrono>
 #include <cmath>
 #include <functional>
 #include <iomanip>
+#include <limits>
 #include <memory>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include <typeinfo>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include <dlfcn.h>
+#include <pthread.h>
+
 #include "../utils/BleachBreak.hpp"
 #include "../utils/BleachCallable.hpp"
 #include "../utils/BleachClass.hpp"
@@ -20,13 +27,23 @@
 #include "../utils/BleachFunction.hpp"
 #include "../utils/BleachReturn.hpp"
 #include "../error/BleachRuntimeError.hpp"
+#include "../extension/Extension.hpp"
 #include "../error/Error.hpp"
 #include "../utils/Environment.hpp"
 #include "../utils/Expr.hpp"
+#include "../utils/ForeignFunctions.hpp"
 #include "../utils/NativeFunctions.hpp"
 #include "../utils/Stmt.hpp"
 
 
+// The interpreter dispatches on the kind of each AST node through a table of label addresses (direct-threaded
+// dispatch), which relies on the "labels as values" extension of GCC and Clang. Building with the
+// "BLEACH_SWITCH_DISPATCH" macro defined ("make DISPATCH=switch"), or with any other compiler, falls back to a
+// portable "switch" statement.
+#if defined(__GNUC__) && !defined(BLEACH_SWITCH_DISPATCH)
+  #define BLEACH_THREADED_DISPATCH
+#endif
+
 /**
  * @class Interpreter
  * 
@@ -42,12 +59,160 @@
 **/
 class Interpreter : public ExprVisitor, public StmtVisitor{
   friend class BleachFunction;
+  friend class NativeHash;
 
   public:
     std::shared_ptr<Environment> globals{new Environment}; /**< Variable that always points to the outermost global environment (global scope). */
+    std::vector<std::string> sources; /**< Variable that stores, in order, the source code of every program run by this instance that has declared a function or a lambda function. Snapshots need it to rebuild such declarations. */
+    int declarationCount = 0; /**< Variable that stores how many function and lambda function declarations have been resolved against this instance. */
+    std::unordered_map<std::string, int> sourceDeclarations; /**< Variable that maps each source stored inside the "sources" attribute to the number of its first declaration, so a program that is run again (e.g. the same line typed twice in the REPL) reuses its numbers instead of being stored again. */
+    int replayedDeclaration = -1; /**< Variable that stores the number given to the next declaration while a program whose source has already been stored is resolved (-1 otherwise). */
+    bool restoringSnapshot = false; /**< Variable that tells whether a snapshot is being restored into this instance. */
+    std::unordered_map<int, std::any> restoredDeclarations; /**< Variable that maps the number of each declaration to its node while a snapshot is being restored. */
+    std::vector<std::string> nativeModules; /**< Variable that stores, in order, the paths of the native modules imported by this instance. Snapshots need it to import them again. */
+    unsigned long sideEffects = 0; /**< Variable that counts the side effects (assignments to fields, calls of impure functions, mutations of lists, ...) that have happened so far. A common subexpression (see the Cached struct) is only reused while it does not change. */
+    unsigned long activation = 0; /**< Variable that numbers the call of a function or lambda function that is running (0 outside of any call). */
+    unsigned long activationCount = 0; /**< Variable that stores how many calls of functions and lambda functions have been numbered so far. */
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max(); /**< Variable that stores the moment after which the program that is running is stopped with a runtime error (see the "checkDeadline" method). By default, there's no such moment. */
+
+    /**
+     * @struct Activation
+     *
+     * @brief Numbers a call of a function or lambda function while it runs, so the common subexpressions stored
+     * by such call (see the CachedValue struct) cannot be reused by another call of the same function (e.g. a
+     * recursive one). The number of the caller is restored once the call ends, even if it ends with an error.
+    **/
+    struct Activation{
+      Interpreter& interpreter;
+      const unsigned long previous;
+
+      Activation(Interpreter& interpreter)
+        : interpreter{interpreter}, previous{interpreter.activation}
+      {
+        interpreter.activation = ++interpreter.activationCount;
+      }
+
+      ~Activation(){
+        interpreter.activation = previous;
+      }
+    };
   private:
     std::shared_ptr<Environment> environment = globals; /**< Variable that tracks the current environment of the interpreter instance. Its value changes during execution as the interpreter enters and exits local scopes. */
-    std::map<std::shared_ptr<Expr>, int> locals; /**< Variable that holds information about how many environments must be traveled between the current one and the enclosing one where the interpreter can find the variable's value. */
+    ValueStack valueStack; /**< Variable that holds the arguments of the calls that are running. Callees receive a view of their arguments (see the ArgumentSpan struct) instead of a list of their own. */
+    const char* stackBase = nullptr; /**< Variable that points into the native stack frame of the outermost call of the "interpret" method that is running (nullptr if there's none). */
+    std::size_t stackBudget = 0; /**< Variable that stores how many bytes of the native stack the program that is running may use (see the "checkStack" method). */
+    static constexpr unsigned int deadlineInterval = 4096; /**< Variable that stores how many calls of the "checkDeadline" method happen between two readings of the clock. */
+    unsigned int statementsUntilDeadline = deadlineInterval; /**< Variable that stores how many calls of the "checkDeadline" method are left until the clock is read again. */
+
+    /**
+     * @brief Returns how many bytes of the native stack of the current thread a program may use: Three quarters
+     * of its size, so the frames of the interpreter between two calls (and the reporting of the error) still fit
+     * inside the rest.
+     *
+     * @return The amount of bytes.
+    **/
+    static std::size_t computeStackBudget(){
+      std::size_t size = 8 << 20; // The default size of the stack of a thread on Linux, used if the real one is unknown.
+      pthread_attr_t attributes;
+      if(pthread_getattr_np(pthread_self(), &attributes) == 0){
+        pthread_attr_getstacksize(&attributes, &size);
+        pthread_attr_destroy(&attributes);
+      }
+
+      return size / 4 * 3;
+    }
+
+    /**
+     * @brief Checks whether the program that is running still has room on the native stack for another call.
+     * Deep (or infinite) recursion would otherwise crash the whole process, including every other program run by
+     * it (see the "Batch Mode" and the "Server Mode").
+     *
+     * @param paren: The closing parenthesis of the call (used to report the error).
+     *
+     * @return Nothing (void).
+     *
+     * @note If there's no room left, then an instance of the BleachRuntimeError class is thrown.
+    **/
+    void checkStack(const Token& paren){
+      char marker;
+      if(stackBase != nullptr && static_cast<std::size_t>(stackBase - &marker) > stackBudget){
+        throw BleachRuntimeError{paren, "Stack overflow: Too many nested calls."};
+      }
+
+      return;
+    }
+
+    /**
+     * @brief Checks whether the deadline of the program that is running has passed. It's called before each
+     * statement and each iteration of a loop, but it only reads the clock once every "deadlineInterval" calls,
+     * so it does not slow down the execution.
+     *
+     * @return Nothing (void).
+     *
+     * @note If the deadline has passed, then an instance of the BleachRuntimeError class is thrown, which stops
+     * the program.
+    **/
+    void checkDeadline(){
+      if(--statementsUntilDeadline != 0){
+        return;
+      }
+
+      statementsUntilDeadline = deadlineInterval;
+      if(std::chrono::steady_clock::now() > deadline){
+        throw BleachRuntimeError{Token{TokenType::IDENTIFIER, "<time limit>", nullptr, 0}, "The program has exceeded its time limit."};
+      }
+
+      return;
+    }
+
+    /**
+     * @class ModuleRegistrar
+     *
+     * @brief Registrar handed to a native module while it's being imported (see the "importNativeModule"
+     * method). It only accepts namespaced names (e.g. "vec::dot") outside of the "std" namespace that are not
+     * defined yet, so a module can neither shadow the standard library nor another module.
+    **/
+    class ModuleRegistrar : public BleachRegistrar{
+      private:
+        Interpreter& interpreter;
+        const std::string& path;
+        std::vector<std::string> definedNames; // The names defined so far, in case the module fails to initialize.
+
+      public:
+        ModuleRegistrar(Interpreter& interpreter, const std::string& path)
+          : interpreter{interpreter}, path{path}
+        {}
+
+        /**
+         * @brief Removes every native function defined so far from the global environment. Used when the module 
+         * fails to initialize, since such native functions run code of a shared library that is unloaded.
+        **/
+        void rollback(){
+          for(const std::string& name : definedNames){
+            interpreter.globals->slots[interpreter.globals->slotOf(name)].reset();
+          }
+          definedNames.clear();
+
+          return;
+        }
+
+        void defineNative(std::shared_ptr<BleachNativeFunction> native) override{
+          const std::string& name = native->getName();
+          if(name.find("::") == std::string::npos || name.rfind("std::", 0) == 0){
+            throw std::runtime_error{"The native module '" + path + "' cannot define the '" + name + "' native function. Its name must be namespaced (e.g. 'vec::dot') and cannot use the 'std' namespace."};
+          }
+
+          auto elem = interpreter.globals->slotIndices.find(name);
+          if(elem != interpreter.globals->slotIndices.end() && interpreter.globals->slots[elem->second].has_value()){
+            throw std::runtime_error{"The native module '" + path + "' cannot define the '" + name + "' native function, since such name is already defined."};
+          }
+
+          definedNames.push_back(name);
+          interpreter.defineNative(std::move(native));
+
+          return;
+        }
+    };
 
     /**
      * @brief Checks whether the provided operand of the unary operator ("-") is a value of type double. 
@@ -135,41 +300,178 @@ class Interpreter : public ExprVisitor, public StmtVisitor{
       return;
     }
 
+    /**
+     * @brief Performs the addition operation ("+") on two already evaluated operands.
+     *
+     * This method works as a helper method for the "visitBinaryExpr" and the "visitAssignExpr" methods. Adding
+     * two numbers produces their sum. Adding a string to a number, an instance or another string produces their
+     * concatenation. Adding two lists produces a new list with the elements of both of them.
+     * 
+     * @param left: The value of the left operand.
+     * @param right: The value of the right operand.
+     * @param op: The token that represents the addition operator.
+     * 
+     * @return The result of the addition.
+     */
+    std::any add(const std::any& left, const std::any& right, const Token& op){
+      if(left.type() == typeid(double) && right.type() == typeid(double)){
+        return std::any_cast<double>(left) + std::any_cast<double>(right);
+      }
+      if(left.type() == typeid(std::string) && right.type() == typeid(std::string)){
+        return std::any_cast<std::string>(left) + std::any_cast<std::string>(right);
+      }
+      if(left.type() == typeid(double) && right.type() == typeid(std::string)){
+        return formatDouble(std::any_cast<double>(left)) + std::any_cast<std::string>(right);
+      }
+      if((left.type() == typeid(std::string) && right.type() == typeid(double))){
+        return std::any_cast<std::string>(left) + formatDouble(std::any_cast<double>(right));
+      }
+      if(left.type() == typeid(std::string) && right.type() == typeid(std::shared_ptr<BleachInstance>)){
+        return std::any_cast<std::string>(left) + std::any_cast<std::shared_ptr<BleachInstance>>(right)->toString(*this);
+      }
+      if(left.type() == typeid(std::shared_ptr<BleachInstance>) && right.type() == typeid(std::string)){
+        return std::any_cast<std::shared_ptr<BleachInstance>>(left)->toString(*this) + std::any_cast<std::string>(right);
+      }
+      if(left.type() == typeid(std::shared_ptr<std::vector<std::any>>) && right.type() == typeid(std::shared_ptr<std::vector<std::any>>)){
+        auto result = std::make_shared<std::vector<std::any>>();
+        auto vec1Ptr = std::any_cast<std::shared_ptr<std::vector<std::any>>>(left);
+        auto vec2Ptr = std::any_cast<std::shared_ptr<std::vector<std::any>>>(right);
+        result->insert(result->end(), vec1Ptr->begin(), vec1Ptr->end());
+        result->insert(result->end(), vec2Ptr->begin(), vec2Ptr->end());
+        return result;
+      }
+
+      throw BleachRuntimeError{op, "Operands must be two numbers, or two strings, or two lists, or one number and one string."};
+    }
+
     /**
      * @brief Works as a helper method that simply sends back an Expr AST node back into the appropriate visit
      * method of the interpreter. 
      *
-     * This method works as a helper method responsible for receiving a Expr node of the AST, calling its 
-     * accept method and passing the current instance of the interpreter to it, so the node can call its 
-     * appropriate visit method and evaluate its "inner" result.
+     * This method works as a helper method responsible for receiving a Expr node of the AST and jumping
+     * straight to the visit method that corresponds to the kind of the node, so the node can have its "inner"
+     * result evaluated. Unlike calling the "accept" method of the node, this does not go through a virtual
+     * call and does not need to recover the node pointer through "shared_from_this".
      * 
      * @param expr: A node of the AST (Abstract Syntax Tree) that represents an Expr node from the Bleach
      * language.
      * 
      * @return The value obtained from the evaluation of the AST node that was passed to this method as its
      * argument.
+     * 
+     * @note The dispatch table below must follow the order of the enumerators of the "ExprKind" enum.
      */
-    std::any evaluate(std::shared_ptr<Expr> expr){
-      return expr->accept(*this);
+    std::any evaluate(const std::shared_ptr<Expr>& expr){
+#ifdef BLEACH_THREADED_DISPATCH
+      static void* const dispatchTable[] = {
+        &&assignExpr, &&binaryExpr, &&cachedExpr, &&callExpr, &&getExpr, &&groupingExpr, &&lambdaFunctionExpr,
+        &&listLiteralExpr, &&literalExpr, &&logicalExpr, &&selfExpr, &&setExpr, &&superExpr, &&ternaryExpr,
+        &&unaryExpr, &&variableExpr
+      };
+
+      goto *dispatchTable[static_cast<int>(expr->kind)];
+
+      assignExpr: return visitAssignExpr(std::static_pointer_cast<Assign>(expr));
+      binaryExpr: return visitBinaryExpr(std::static_pointer_cast<Binary>(expr));
+      cachedExpr: return visitCachedExpr(std::static_pointer_cast<Cached>(expr));
+      callExpr: return visitCallExpr(std::static_pointer_cast<Call>(expr));
+      getExpr: return visitGetExpr(std::static_pointer_cast<Get>(expr));
+      groupingExpr: return visitGroupingExpr(std::static_pointer_cast<Grouping>(expr));
+      lambdaFunctionExpr: return visitLambdaFunctionExpr(std::static_pointer_cast<LambdaFunction>(expr));
+      listLiteralExpr: return visitListLiteralExpr(std::static_pointer_cast<ListLiteral>(expr));
+      literalExpr: return visitLiteralExpr(std::static_pointer_cast<Literal>(expr));
+      logicalExpr: return visitLogicalExpr(std::static_pointer_cast<Logical>(expr));
+      selfExpr: return visitSelfExpr(std::static_pointer_cast<Self>(expr));
+      setExpr: return visitSetExpr(std::static_pointer_cast<Set>(expr));
+      superExpr: return visitSuperExpr(std::static_pointer_cast<Super>(expr));
+      ternaryExpr: return visitTernaryExpr(std::static_pointer_cast<Ternary>(expr));
+      unaryExpr: return visitUnaryExpr(std::static_pointer_cast<Unary>(expr));
+      variableExpr: return visitVariableExpr(std::static_pointer_cast<Variable>(expr));
+#else
+      switch(expr->kind){
+        case(ExprKind::ASSIGN): return visitAssignExpr(std::static_pointer_cast<Assign>(expr));
+        case(ExprKind::BINARY): return visitBinaryExpr(std::static_pointer_cast<Binary>(expr));
+        case(ExprKind::CACHED): return visitCachedExpr(std::static_pointer_cast<Cached>(expr));
+        case(ExprKind::CALL): return visitCallExpr(std::static_pointer_cast<Call>(expr));
+        case(ExprKind::GET): return visitGetExpr(std::static_pointer_cast<Get>(expr));
+        case(ExprKind::GROUPING): return visitGroupingExpr(std::static_pointer_cast<Grouping>(expr));
+        case(ExprKind::LAMBDAFUNCTION): return visitLambdaFunctionExpr(std::static_pointer_cast<LambdaFunction>(expr));
+        case(ExprKind::LISTLITERAL): return visitListLiteralExpr(std::static_pointer_cast<ListLiteral>(expr));
+        case(ExprKind::LITERAL): return visitLiteralExpr(std::static_pointer_cast<Literal>(expr));
+        case(ExprKind::LOGICAL): return visitLogicalExpr(std::static_pointer_cast<Logical>(expr));
+        case(ExprKind::SELF): return visitSelfExpr(std::static_pointer_cast<Self>(expr));
+        case(ExprKind::SET): return visitSetExpr(std::static_pointer_cast<Set>(expr));
+        case(ExprKind::SUPER): return visitSuperExpr(std::static_pointer_cast<Super>(expr));
+        case(ExprKind::TERNARY): return visitTernaryExpr(std::static_pointer_cast<Ternary>(expr));
+        case(ExprKind::UNARY): return visitUnaryExpr(std::static_pointer_cast<Unary>(expr));
+        case(ExprKind::VARIABLE): return visitVariableExpr(std::static_pointer_cast<Variable>(expr));
+      }
+
+      // Unreachable
+      return {};
+#endif
     }
 
     /**
      * @brief Works as a helper method that simply sends back the Stmt AST node back into the appropriate visit
      * method of the interpreter. 
      *
-     * This method works as a helper method responsible for receiving a Stmt node of the AST, calling its 
-     * accept method and passing the current instance of the interpreter to it, so the node can call its 
-     * appropriate visit method and execute its "inner" functionality.
+     * This method works as a helper method responsible for receiving a Stmt node of the AST and jumping
+     * straight to the visit method that corresponds to the kind of the node, so the node can execute its 
+     * "inner" functionality. It works exactly like the "evaluate" method above.
      * 
      * @param stmt: A node of an AST (Abstract Syntax Tree) that represents a Stmt node from the Bleach 
      * language.
      * 
      * @return Nothing (void).
+     * 
+     * @note The dispatch table below must follow the order of the enumerators of the "StmtKind" enum.
      */
-    void execute(std::shared_ptr<Stmt> stmt){
-      stmt->accept(*this);
+    void execute(const std::shared_ptr<Stmt>& stmt){
+      checkDeadline();
+
+#ifdef BLEACH_THREADED_DISPATCH
+      static void* const dispatchTable[] = {
+        &&blockStmt, &&breakStmt, &&classStmt, &&continueStmt, &&doWhileStmt, &&expressionStmt, &&forStmt,
+        &&functionStmt, &&ifStmt, &&importStmt, &&printStmt, &&returnStmt, &&varStmt, &&whileStmt
+      };
+
+      goto *dispatchTable[static_cast<int>(stmt->kind)];
+
+      blockStmt: visitBlockStmt(std::static_pointer_cast<Block>(stmt)); return;
+      breakStmt: visitBreakStmt(std::static_pointer_cast<Break>(stmt)); return;
+      classStmt: visitClassStmt(std::static_pointer_cast<Class>(stmt)); return;
+      continueStmt: visitContinueStmt(std::static_pointer_cast<Continue>(stmt)); return;
+      doWhileStmt: visitDoWhileStmt(std::static_pointer_cast<DoWhile>(stmt)); return;
+      expressionStmt: visitExpressionStmt(std::static_pointer_cast<Expression>(stmt)); return;
+      forStmt: visitForStmt(std::static_pointer_cast<For>(stmt)); return;
+      functionStmt: visitFunctionStmt(std::static_pointer_cast<Function>(stmt)); return;
+      ifStmt: visitIfStmt(std::static_pointer_cast<If>(stmt)); return;
+      importStmt: visitImportStmt(std::static_pointer_cast<Import>(stmt)); return;
+      printStmt: visitPrintStmt(std::static_pointer_cast<Print>(stmt)); return;
+      returnStmt: visitReturnStmt(std::static_pointer_cast<Return>(stmt)); return;
+      varStmt: visitVarStmt(std::static_pointer_cast<Var>(stmt)); return;
+      whileStmt: visitWhileStmt(std::static_pointer_cast<While>(stmt)); return;
+#else
+      switch(stmt->kind){
+        case(StmtKind::BLOCK): visitBlockStmt(std::static_pointer_cast<Block>(stmt)); break;
+        case(StmtKind::BREAK): visitBreakStmt(std::static_pointer_cast<Break>(stmt)); break;
+        case(StmtKind::CLASS): visitClassStmt(std::static_pointer_cast<Class>(stmt)); break;
+        case(StmtKind::CONTINUE): visitContinueStmt(std::static_pointer_cast<Continue>(stmt)); break;
+        case(StmtKind::DOWHILE): visitDoWhileStmt(std::static_pointer_cast<DoWhile>(stmt)); break;
+        case(StmtKind::EXPRESSION): visitExpressionStmt(std::static_pointer_cast<Expression>(stmt)); break;
+        case(StmtKind::FOR): visitForStmt(std::static_pointer_cast<For>(stmt)); break;
+        case(StmtKind::FUNCTION): visitFunctionStmt(std::static_pointer_cast<Function>(stmt)); break;
+        case(StmtKind::IF): visitIfStmt(std::static_pointer_cast<If>(stmt)); break;
+        case(StmtKind::IMPORT): visitImportStmt(std::static_pointer_cast<Import>(stmt)); break;
+        case(StmtKind::PRINT): visitPrintStmt(std::static_pointer_cast<Print>(stmt)); break;
+        case(StmtKind::RETURN): visitReturnStmt(std::static_pointer_cast<Return>(stmt)); break;
+        case(StmtKind::VAR): visitVarStmt(std::static_pointer_cast<Var>(stmt)); break;
+        case(StmtKind::WHILE): visitWhileStmt(std::static_pointer_cast<While>(stmt)); break;
+      }
 
       return;
+#endif
     }
 
     /**
@@ -178,13 +480,34 @@ class Interpreter : public ExprVisitor, public StmtVisitor{
      * This method is responsible for checking whether the operands of the following binary operator ("==") 
      * are of the same type. If that's the case, then the method also checks whether or not such operands have
      * the same value.
+     * Lists are equal when they have the same length and their elements are equal, in order. Instances are
+     * equal when they are the same instance or, if they have an "eq" method, when such method returns a
+     * "truthy" value.
      * 
      * @param left: The value of the left operand of the "==" operator.
      * @param right: The value of the right operand of the "==" operator.
+     * @param op: The token of the "==" operator (used to report errors of the "eq" method).
      * 
      * @return A boolean that signal whether the values of the two provided operands are equal or not.
      */
-    bool isEqual(const std::any& left, const std::any& right){
+    bool isEqual(const std::any& left, const std::any& right, const Token& op){
+      std::vector<std::pair<const std::vector<std::any>*, const std::vector<std::any>*>> comparing;
+
+      return isEqual(left, right, op, comparing);
+    }
+
+    /**
+     * @brief Checks whether two values are equal (see the other overload of this method).
+     *
+     * @param left: The first value.
+     * @param right: The second value.
+     * @param op: The token of the "==" operator.
+     * @param comparing: The pairs of lists that are being compared. A pair that is compared again (because the
+     * lists contain themselves) is considered equal, so the comparison ends.
+     *
+     * @return A boolean that signal whether the two values are equal or not.
+    **/
+    bool isEqual(const std::any& left, const std::any& right, const Token& op, std::vector<std::pair<const std::vector<std::any>*, const std::vector<std::any>*>>& comparing){
       if(left.type() == typeid(nullptr) && right.type() == typeid(nullptr)){
         return true;
       }
@@ -198,13 +521,137 @@ class Interpreter : public ExprVisitor, public StmtVisitor{
         return std::any_cast<double>(left) == std::any_cast<double>(right);
       }
       if(left.type() == typeid(std::string) && right.type() == typeid(std::string)){
-        return std::any_cast<std::string>(left) == std::any_cast<std::string>(right);
+        return *std::any_cast<std::string>(&left) == *std::any_cast<std::string>(&right);
+      }
+      if(left.type() == typeid(std::shared_ptr<std::vector<std::any>>) && right.type() == typeid(std::shared_ptr<std::vector<std::any>>)){
+        const std::vector<std::any>* leftList = std::any_cast<std::shared_ptr<std::vector<std::any>>>(&left)->get();
+        const std::vector<std::any>* rightList = std::any_cast<std::shared_ptr<std::vector<std::any>>>(&right)->get();
+        if(leftList == rightList){
+          return true;
+        }
+        if(leftList->size() != rightList->size()){
+          return false;
+        }
+        for(const auto& pair : comparing){
+          if(pair.first == leftList && pair.second == rightList){
+            return true;
+          }
+        }
+
+        comparing.emplace_back(leftList, rightList);
+        for(std::size_t i = 0; i < leftList->size(); i++){
+          if(i >= rightList->size() || !isEqual((*leftList)[i], (*rightList)[i], op, comparing)){ // The "eq" method of an instance may have resized the lists.
+            comparing.pop_back();
+            return false;
+          }
+        }
+        comparing.pop_back();
+
+        return leftList->size() == rightList->size();
+      }
+      if(left.type() == typeid(std::shared_ptr<BleachInstance>) && right.type() == typeid(std::shared_ptr<BleachInstance>)){
+        static const int eqId = SymbolTable::intern("eq");
+
+        const auto& instance = *std::any_cast<std::shared_ptr<BleachInstance>>(&left);
+        if(instance == *std::any_cast<std::shared_ptr<BleachInstance>>(&right)){
+          return true;
+        }
+
+        std::shared_ptr<BleachFunction> method = instance->findMethod(eqId);
+        if(method == nullptr){
+          return false;
+        }
+        if(method->arity() != 1){
+          throw BleachRuntimeError{op, "The 'eq' method of an instance must expect exactly 1 argument."};
+        }
+
+        ValueStack::Frame frame{valueStack, 1};
+        frame[0] = right;
+
+        return isTruthy(method->call(*this, instance, frame.arguments()));
       }
-      // #TODO: Extend this to deal with 'lists' and 'dicts'.
 
       return false;
     }
 
+    /**
+     * @brief Computes the hash of a value (see the "std::utils::hash" native function).
+     *
+     * This method is responsible for computing a hash that is consistent with the "isEqual" method: Equal
+     * values always have the same hash. The hash of a list combines the hashes of its elements, and the hash of
+     * an instance is the number returned by its "hash" method or, if there's no such method, is
+     * derived from the identity of the instance.
+     *
+     * @param value: The value whose hash will be computed.
+     * @param paren: The closing parenthesis of the call (used to report errors).
+     * @param lists: The lists whose hash is being computed (used to detect lists that contain themselves).
+     *
+     * @return The hash of the value.
+     *
+     * @note Lists that contain themselves, functions, classes and native objects cannot be hashed, and neither
+     * can instances that have an "eq" method but not a "hash" method.
+    **/
+    std::size_t hash(const std::any& value, const Token& paren, std::vector<const std::vector<std::any>*>& lists){
+      if(value.type() == typeid(nullptr)){
+        return 0x9e3779b97f4a7c15ull;
+      }
+      if(value.type() == typeid(bool)){
+        return std::hash<bool>{}(*std::any_cast<bool>(&value));
+      }
+      if(value.type() == typeid(double)){
+        double number = *std::any_cast<double>(&value);
+        if(number == 0){ // 0 and -0 are equal, so they must share the same hash.
+          number = 0;
+        }
+        return std::hash<double>{}(number);
+      }
+      if(value.type() == typeid(std::string)){
+        return std::hash<std::string>{}(*std::any_cast<std::string>(&value));
+      }
+      if(value.type() == typeid(std::shared_ptr<std::vector<std::any>>)){
+        const std::vector<std::any>* list = std::any_cast<std::shared_ptr<std::vector<std::any>>>(&value)->get();
+        for(const std::vector<std::any>* outer : lists){
+          if(outer == list){
+            throw BleachRuntimeError{paren, "A list that contains itself cannot be hashed."};
+          }
+        }
+
+        std::size_t seed = list->size();
+        lists.push_back(list);
+        for(std::size_t i = 0; i < list->size(); i++){
+          seed ^= hash((*list)[i], paren, lists) + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+        }
+        lists.pop_back();
+
+        return seed;
+      }
+      if(value.type() == typeid(std::shared_ptr<BleachInstance>)){
+        static const int eqId = SymbolTable::intern("eq");
+        static const int hashId = SymbolTable::intern("hash");
+
+        const auto& instance = *std::any_cast<std::shared_ptr<BleachInstance>>(&value);
+        std::shared_ptr<BleachFunction> method = instance->findMethod(hashId);
+        if(method == nullptr){
+          if(instance->findMethod(eqId) != nullptr){
+            throw BleachRuntimeError{paren, "An instance that has an 'eq' method but not a 'hash' method cannot be hashed."};
+          }
+          return std::hash<BleachInstance*>{}(instance.get());
+        }
+        if(method->arity() != 0){
+          throw BleachRuntimeError{paren, "The 'hash' method of an instance must not expect any argument."};
+        }
+
+        std::any result = method->call(*this, instance, ArgumentSpan{});
+        if(result.type() != typeid(double)){
+          throw BleachRuntimeError{paren, "The 'hash' method of an instance must return a number."};
+        }
+
+        return hash(result, paren, lists);
+      }
+
+      throw BleachRuntimeError{paren, "Only nil, booleans, numbers, strings, lists and instances can be hashed."};
+    }
+
     /**
      * @brief Checks whether the value of the a Bleach object is considered "truthy" or not.
      *
@@ -272,21 +719,20 @@ class Interpreter : public ExprVisitor, public StmtVisitor{
      * variable's name.
      *
      * This method is responsible for receiving a token whose lexeme represents the name of a variable and also
-     * an expression that represents the AST node of such variable during the parsing phase.
+     * the resolution data that the Resolver stored inside the AST node of such variable.
      * 
      * @param name: A token whose lexeme is the name of a variable whose value the interpreter is trying
      * retrieve.
-     * @param expr: An expression that represents the AST node of such variable in the parsing stage.
+     * @param depth: The distance (in environments) to the variable, or -1 if it is a global variable.
+     * @param globalSlot: The slot of the variable inside the global environment, if it is a global variable.
      * 
      * @return The value that is bound to the variable that has been requested.
      */
-    std::any lookUpVariable(const Token& name, std::shared_ptr<Expr> expr){
-      auto elem = locals.find(expr);
-      if(elem != locals.end()){ // If the Variable expression has been found here, then it means that it is a local variable.
-        int distance = elem->second;
-        return environment->getAt(name.lexeme, distance);
+    std::any lookUpVariable(const Token& name, int depth, int globalSlot){
+      if(depth != -1){ // If the Resolver has found the variable in a local scope, then it means that it is a local variable.
+        return environment->getAt(name.lexeme, depth);
       }else{ // Otherwise, it is assumed that the variable was declared in the global scope.
-        return globals->get(name); // Global variable are treated in a special way. If a global variable is not found, the a runtime error is thrown by the BLEACH Interpreter.
+        return globals->getSlot(globalSlot, name); // Global variable are treated in a special way. If a global variable is not found, the a runtime error is thrown by the BLEACH Interpreter.
       }
     }
 
@@ -351,63 +797,206 @@ class Interpreter : public ExprVisitor, public StmtVisitor{
 
         return listAsString;
       }
-      if(object.type() == typeid(std::shared_ptr<NativeClock>)){
-        return std::any_cast<std::shared_ptr<NativeClock>>(object)->toString();
+      if(object.type() == typeid(std::shared_ptr<BleachNativeFunction>)){
+        return std::any_cast<const std::shared_ptr<BleachNativeFunction>&>(object)->toString();
       }
-      if(object.type() == typeid(std::shared_ptr<NativeReadLine>)){
-        return std::any_cast<std::shared_ptr<NativeReadLine>>(object)->toString();
+      if(object.type() == typeid(std::shared_ptr<BleachNativeObject>)){
+        return std::any_cast<const std::shared_ptr<BleachNativeObject>&>(object)->toString();
       }
-      if(object.type() == typeid(std::shared_ptr<NativePrint>)){
-        return std::any_cast<std::shared_ptr<NativePrint>>(object)->toString();
-      }
-      if(object.type() == typeid(std::shared_ptr<NativeFileRead>)){
-        return std::any_cast<std::shared_ptr<NativeFileRead>>(object)->toString();
+
+      return "Error in stringify: object type not recognized.";
+    }
+
+    /**
+     * @brief Defines a native function inside the global environment, under its own name.
+     *
+     * @param native: The native function. It's stored as a "std::shared_ptr<BleachNativeFunction>", so every
+     * native function can be recognized through a single type.
+     */
+    void defineNative(std::shared_ptr<BleachNativeFunction> native){
+      std::string name = native->getName();
+      globals->define(name, std::move(native));
+
+      return;
+    }
+
+    /**
+     * @brief Imports a native module: Loads the shared library, checks that it has been compiled against the
+     * same version of the "extension/Extension.hpp" header and lets it register its native functions.
+     * 
+     * A module is only imported once by each instance (importing it again does nothing), and the shared library
+     * is never unloaded, since the native functions it has registered might still be held by the program. The 
+     * only exception is a module whose initialization throws: The native functions it has registered so far are
+     * removed and the shared library is unloaded.
+     * 
+     * @param path: The path of the shared library.
+     * 
+     * @return Nothing (void).
+     * 
+     * @note If the module cannot be imported, then an instance of the std::runtime_error class is thrown.
+     */
+    void importNativeModule(const std::string& path){
+      for(const std::string& module : nativeModules){
+        if(module == path){
+          return;
+        }
       }
-      if(object.type() == typeid(std::shared_ptr<NativeFileWrite>)){
-        return std::any_cast<std::shared_ptr<NativeFileWrite>>(object)->toString();
+
+      void* handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+      if(handle == nullptr){
+        const char* reason = dlerror();
+        throw std::runtime_error{"Could not load the native module '" + path + "': " + (reason != nullptr ? reason : "unknown error") + "."};
       }
-      if(object.type() == typeid(std::shared_ptr<NativeAbsoluteValue>)){
-        return std::any_cast<std::shared_ptr<NativeAbsoluteValue>>(object)->toString();
+
+      auto version = reinterpret_cast<int (*)()>(dlsym(handle, "bleachExtensionVersion"));
+      auto init = reinterpret_cast<void (*)(BleachRegistrar&)>(dlsym(handle, "bleachExtensionInit"));
+      if(version == nullptr || init == nullptr){
+        dlclose(handle);
+        throw std::runtime_error{"The shared library '" + path + "' is not a Bleach native module (see the BLEACH_EXTENSION macro)."};
       }
-      if(object.type() == typeid(std::shared_ptr<NativeLogarithm>)){
-        return std::any_cast<std::shared_ptr<NativeLogarithm>>(object)->toString();
+      if(version() != BLEACH_EXTENSION_VERSION){
+        dlclose(handle);
+        throw std::runtime_error{"The native module '" + path + "' has been compiled against version " + std::to_string(version()) + " of the extension interface, but this interpreter provides version " + std::to_string(BLEACH_EXTENSION_VERSION) + "."};
       }
-      if(object.type() == typeid(std::shared_ptr<NativeExponentiation>)){
-        return std::any_cast<std::shared_ptr<NativeExponentiation>>(object)->toString();
+
+      ModuleRegistrar registrar{*this, path};
+      std::string failure; // The message is copied before unloading the library, since the exception may have been defined by it.
+      bool failed = false;
+      try{
+        init(registrar);
+      }catch(const std::exception& exception){
+        failure = exception.what();
+        failed = true;
+      }catch(...){
+        failure = "unknown error";
+        failed = true;
       }
-      if(object.type() == typeid(std::shared_ptr<NativeSquareRoot>)){
-        return std::any_cast<std::shared_ptr<NativeSquareRoot>>(object)->toString();
+      if(failed){
+        registrar.rollback();
+        dlclose(handle);
+        throw std::runtime_error{"The native module '" + path + "' failed to initialize: " + failure + "."};
       }
-      if(object.type() == typeid(std::shared_ptr<NativeRandom>)){
-        return std::any_cast<std::shared_ptr<NativeRandom>>(object)->toString();
+      nativeModules.push_back(path);
+
+      return;
+    }
+
+    Interpreter(){
+      defineNative(bindNative<double()>("std::chrono::clock", nativeClock));
+      defineNative(bindNative<std::string()>("std::io::readLine", nativeReadLine));
+      defineNative(std::make_shared<NativePrint>());
+      defineNative(bindNative<std::string(std::string)>("std::io::fileRead", nativeFileRead));
+      defineNative(bindNative<void(std::string, std::string, std::string, bool)>("std::io::fileWrite", nativeFileWrite));
+      defineNative(pureNative(bindNative<double(double)>("std::math::abs", [](double number){ return std::fabs(number); })));
+      defineNative(pureNative(bindNative<double(double)>("std::math::ceil", nativeCeil)));
+      defineNative(pureNative(bindNative<double(double)>("std::math::floor", [](double value){ return std::floor(value); })));
+      defineNative(pureNative(bindNative<double(double, double)>("std::math::log", nativeLogarithm)));
+      defineNative(pureNative(bindNative<double(double, double)>("std::math::pow", [](double base, double exponent){ return std::pow(base, exponent); })));
+      defineNative(pureNative(bindNative<double(double)>("std::math::sqrt", nativeSquareRoot)));
+      defineNative(bindNative<std::shared_ptr<BleachNativeObject>(std::string)>("std::ffi::load", ForeignLibrary::load));
+      defineNative(std::make_shared<NativeMemoize>());
+      defineNative(bindNative<double(double, double)>("std::random::random", nativeRandom));
+      defineNative(std::make_shared<NativeSnapshot>());
+      defineNative(std::make_shared<NativeSerialDump>());
+      defineNative(std::make_shared<NativeSerialLoad>());
+      defineNative(std::make_shared<NativeSerialDumpFile>());
+      defineNative(std::make_shared<NativeSerialLoadFile>());
+      defineNative(std::make_shared<NativeHash>());
+      defineNative(pureNative(bindNative<double(std::string)>("std::utils::ord", nativeOrd)));
+      defineNative(pureNative(bindNative<double(std::string)>("std::utils::strToNum", nativeStringToNumber)));
+      defineNative(pureNative(bindNative<bool(std::string)>("std::utils::strToBool", nativeStringToBool)));
+      defineNative(pureNative(bindNative<std::nullptr_t(std::string)>("std::utils::strToNil", nativeStringToNil)));
+    }
+
+    /**
+     * @brief Destroys the Interpreter, releasing the values of the global variables first.
+     *
+     * Functions and classes declared at the global scope refer to the global environment (their closure), which
+     * in turn refers to them. Emptying the global environment breaks such cycles, so an isolate (see the
+     * "Batch Mode" and the "Server Mode") does not leak the memory of the program it has run.
+     */
+    ~Interpreter(){
+      for(std::any& slot : globals->slots){
+        slot.reset();
       }
-      if(object.type() == typeid(std::shared_ptr<NativeOrd>)){
-        return std::any_cast<std::shared_ptr<NativeOrd>>(object)->toString();
+      globals->values.clear();
+    }
+
+    /**
+     * @brief Returns the superclass method that a Super expression node refers to.
+     *
+     * This method is responsible for returning the method cached inside the Super expression node when its
+     * enclosing class was finalized. If there's no such cached method (because the class declaration has been
+     * executed with more than one superclass), the superclass is fetched from the environment and the method is
+     * looked up in its method table.
+     *
+     * @param expr: The Super expression node.
+     * @param distance: The distance between the current environment and the one where "super" is bound.
+     *
+     * @return The runtime representation of the superclass method.
+     *
+     * @note: If the superclass does not have (or inherit) the required method, then an instance of the 
+     * BleachRuntimeError class is thrown.
+    **/
+    std::shared_ptr<BleachFunction> findSuperMethod(const std::shared_ptr<Super>& expr, int distance){
+      std::shared_ptr<BleachFunction> method = expr->cachedMethod;
+
+      if(method == nullptr){
+        auto superclass = std::any_cast<std::shared_ptr<BleachClass>>(environment->getAt("super", distance));
+        method = superclass->findMethod(expr->methodId);
       }
-      if(object.type() == typeid(std::shared_ptr<NativeStringToNumber>)){
-        return std::any_cast<std::shared_ptr<NativeStringToNumber>>(object)->toString();
+
+      if(method == nullptr){
+        throw BleachRuntimeError{expr->method, "Undefined property (field or method):" + expr->method.lexeme + "."};
       }
 
-      return "Error in stringify: object type not recognized.";
+      return method;
     }
 
-    Interpreter(){
-      globals->define("std::chrono::clock", std::make_shared<NativeClock>());
-      globals->define("std::io::readLine", std::make_shared<NativeReadLine>());
-      globals->define("std::io::print", std::make_shared<NativePrint>());
-      globals->define("std::io::fileRead", std::make_shared<NativeFileRead>());
-      globals->define("std::io::fileWrite", std::make_shared<NativeFileWrite>());
-      globals->define("std::math::abs", std::make_shared<NativeAbsoluteValue>());
-      globals->define("std::math::ceil", std::make_shared<NativeCeil>());
-      globals->define("std::math::floor", std::make_shared<NativeFloor>());
-      globals->define("std::math::log", std::make_shared<NativeLogarithm>());
-      globals->define("std::math::pow", std::make_shared<NativeExponentiation>());
-      globals->define("std::math::sqrt", std::make_shared<NativeSquareRoot>());
-      globals->define("std::random::random", std::make_shared<NativeRandom>());
-      globals->define("std::utils::ord", std::make_shared<NativeOrd>());
-      globals->define("std::utils::strToNum", std::make_shared<NativeStringToNumber>());
-      globals->define("std::utils::strToBool", std::make_shared<NativeStringToBool>());
-      globals->define("std::utils::strToNil", std::make_shared<NativeStringToNil>());
+    /**
+     * @brief Performs a call whose callee is a Super expression node (e.g. "super.init(...)").
+     *
+     * This method is responsible for calling a superclass method directly on the current "self", without 
+     * creating a bound copy of such method (as the "visitSuperExpr" method does).
+     *
+     * @param superExpr: The Super expression node that is the callee of the call.
+     * @param expr: The Call expression node.
+     *
+     * @return The value returned by the superclass method.
+    **/
+    std::any callSuperMethod(const std::shared_ptr<Super>& superExpr, const std::shared_ptr<Call>& expr){
+      int distance = superExpr->depth; // The "super" keyword is always resolved as a local variable.
+
+      std::shared_ptr<BleachFunction> method = findSuperMethod(superExpr, distance);
+      auto object = std::any_cast<std::shared_ptr<BleachInstance>>(environment->getAt("self", distance - 1));
+
+      return callMethod(method, std::move(object), expr);
+    }
+
+    /**
+     * @brief Evaluates the arguments of a Call expression node and calls a method directly on an instance.
+     *
+     * This method is responsible for calling a method on an instance without creating a bound copy of such 
+     * method. It's used by calls of the form "object.method(...)" and "super.method(...)".
+     *
+     * @param method: The runtime representation of the method.
+     * @param object: The instance on which the method is called (the value of "self" inside the method).
+     * @param expr: The Call expression node.
+     *
+     * @return The value returned by the method.
+    **/
+    std::any callMethod(const std::shared_ptr<BleachFunction>& method, std::shared_ptr<BleachInstance> object, const std::shared_ptr<Call>& expr){
+      ValueStack::Frame frame{valueStack, expr->arguments.size()};
+      for(std::size_t i = 0; i < expr->arguments.size(); i++){
+        frame[i] = evaluate(expr->arguments[i]);
+      }
+      ArgumentSpan arguments = frame.arguments();
+
+      if(arguments.size() != method->arity()){
+        throw BleachRuntimeError{expr->paren, "Expected " + std::to_string(method->arity()) + " arguments, but instead received " + std::to_string(arguments.size()) + "."};
+      }
+
+      return method->call(*this, std::move(object), arguments);
     }
 
     /**
@@ -423,37 +1012,111 @@ class Interpreter : public ExprVisitor, public StmtVisitor{
      * @return Nothing (void).
      */
     void interpret(const std::vector<std::shared_ptr<Stmt>>& statements){
+      char marker;
+      bool outermost = (stackBase == nullptr);
+      if(outermost){ // The native stack used by the program is measured from here (see the "checkStack" method).
+        stackBase = &marker;
+        stackBudget = computeStackBudget();
+      }
+
       try{
         for(const std::shared_ptr<Stmt>& statement : statements){
           execute(statement);
         }
       }catch(BleachRuntimeError error){
         runtimeError(error);
+      }catch(...){
+        if(outermost){
+          stackBase = nullptr;
+        }
+        throw;
+      }
+
+      if(outermost){
+        stackBase = nullptr;
       }
 
       return;
     }
 
-  /**
-     * @brief Performs a binding between an expression that represents a variable and its respective depth (the
-     * position in the environment chain where the Environment instance that contains such variable is).
+    /**
+     * @brief Returns the slot that a global variable occupies inside the global environment.
      * 
-     * This method is responsible for receiving an expression that represents a variable in the AST of the
-     * Bleach language after the parsing stage and also an integer that tells the interpreter how many hops 
-     * must be followed from the current Environment instance that the interpreter is on until the Environment
-     * instance where such variable is present is reached. With these two pieces of information, the interpreter
-     * can figure out where any local variable is (with respect to Environment instances).
+     * This method is responsible for binding every reference to a global variable (a variable that the Resolver
+     * has not found in any local scope) to a slot of the global environment. Such slot is stable: Every 
+     * reference to the same name gets the same slot, even if the variable is only defined later on.
      * 
-     * @param expr: An expression that represents the AST node of the variable.
-     * @param depth: An integer that represents how many hops must be followed from the current Environment
-     * instance that the interpreter is on to find the desired local variable.
+     * @param name: The name of the global variable.
      * 
-     * @return Nothing (void).
+     * @return The index of the slot of the global variable.
      */
-    void resolve(std::shared_ptr<Expr> expr, int depth){
-      locals[expr] = depth;
+    int resolveGlobal(const std::string& name){
+      return globals->slotOf(name);
+    }
 
-      return;
+    /**
+     * @brief Numbers a function or a lambda function declaration that is being resolved.
+     * 
+     * This method is responsible for giving every function and lambda function declaration resolved against 
+     * this instance a sequential number. Snapshots (see the SnapshotWriter class) refer to the declaration of 
+     * a function by such number: When a snapshot is restored, the sources recorded inside the "sources" 
+     * attribute are resolved again, in the same order, so every declaration gets the same number back. While
+     * that happens, the "restoredDeclarations" attribute maps each number to its declaration.
+     * The declarations of a program whose source has already been stored get the numbers given to the ones of 
+     * its first run (see the "replayedDeclaration" attribute): Both runs declare the same functions, in the same
+     * order, so either can be rebuilt from the stored source.
+     * 
+     * @param declaration: The declaration node (an instance of the Function or of the LambdaFunction struct).
+     * 
+     * @return The number of the declaration.
+     */
+    int registerDeclaration(std::any declaration){
+      if(replayedDeclaration >= 0){
+        return replayedDeclaration++;
+      }
+      if(restoringSnapshot){
+        restoredDeclarations[declarationCount] = std::move(declaration);
+      }
+
+      return declarationCount++;
+    }
+
+    /**
+     * @brief Executes the body of a function whose only return statement is its last statement, and returns
+     * the value produced by such return statement.
+     *
+     * This method works exactly as the "executeBlock" method below, but it evaluates the value of the last 
+     * statement (a return statement) directly instead of executing it. Therefore, there's no need to throw an 
+     * instance of the BleachReturn struct in order to leave the function.
+     * 
+     * @param statements: The body of the function. Its last statement must be a return statement.
+     * @param enviroment: The just created environment of the function.
+     * 
+     * @return The value of the return statement (nil, if it has no value).
+     */
+    std::any executeTailReturnBlock(const std::vector<std::shared_ptr<Stmt>>& statements, std::shared_ptr<Environment> environment){
+      std::shared_ptr<Environment> previous = this->environment;
+      std::any value = nullptr;
+
+      try{
+        this->environment = environment;
+
+        for(int i = 0; i + 1 < statements.size(); i++){
+          execute(statements[i]);
+        }
+
+        const std::shared_ptr<Expr>& returnValue = std::static_pointer_cast<Return>(statements.back())->value;
+        if(returnValue != nullptr){
+          value = evaluate(returnValue);
+        }
+      }catch(...){
+        this->environment = previous;
+        throw;
+      }
+
+      this->environment = previous;
+
+      return value;
     }
 
     /**
@@ -504,6 +1167,13 @@ class Interpreter : public ExprVisitor, public StmtVisitor{
      * @note This method is an overridden version of the "visitBlockStmt" method from the "StmtVisitor" struct.
      */
     std::any visitBlockStmt(std::shared_ptr<Block> stmt) override{
+      if(!stmt->needsScope){ // The block does not declare anything, so its statements can run in the current environment.
+        for(const std::shared_ptr<Stmt>& statement : stmt->statements){
+          execute(statement);
+        }
+        return {};
+      }
+
       executeBlock(stmt->statements, std::make_shared<Environment>(environment)); // In order to execute a 'Block' statement, the interpreter needs to create an environment that represents the lexical/static scope of the block and it also needs to execute each statement inside the block.
 
       return {};
@@ -564,7 +1234,23 @@ class Interpreter : public ExprVisitor, public StmtVisitor{
       if(superclass.type() == typeid(std::shared_ptr<BleachClass>)){
         superklass = std::any_cast<std::shared_ptr<BleachClass>>(superclass);
       }
-      auto klass = std::make_shared<BleachClass>(stmt->name.lexeme, superklass, methods);
+      auto klass = std::make_shared<BleachClass>(stmt->name.lexeme, superklass, methods, stmt->fieldIds);
+
+      if(superklass != nullptr){ // Once the class is finalized, every "super.method" expression inside its methods can be resolved to the exact superclass method.
+        for(const std::shared_ptr<Super>& superExpr : stmt->superExprs){
+          if(superExpr->polymorphic){ // Classes built from other superclasses may still be alive, so the node never caches a method again.
+            continue;
+          }
+          std::shared_ptr<BleachClass> cachedSuperclass = superExpr->cachedSuperclass.lock();
+          if(cachedSuperclass == nullptr){ // First execution of the declaration (or the superclass it was resolved against is gone).
+            superExpr->cachedSuperclass = superklass;
+            superExpr->cachedMethod = superklass->findMethod(superExpr->methodId);
+          }else if(cachedSuperclass != superklass){ // The declaration has been executed with another superclass. Then, the method must be looked up at every evaluation.
+            superExpr->polymorphic = true;
+            superExpr->cachedMethod = nullptr;
+          }
+        }
+      }
 
       if(superklass != nullptr){
         environment = environment->enclosing;
@@ -610,10 +1296,13 @@ class Interpreter : public ExprVisitor, public StmtVisitor{
       std::shared_ptr<Environment> previous = this->environment; // Stores the current environment that the interpreter is looking at inside this "previous" variable.
 
       try{
-        this->environment = std::make_shared<Environment>(previous); // Make the current environment that the interpreter is looking at be the environment of the block statement that is being visited.
+        if(stmt->needsScope){ // Loops that do not declare anything run in the current environment.
+          this->environment = std::make_shared<Environment>(previous); // Make the current environment that the interpreter is looking at be the environment of the block statement that is being visited.
+        }
         
         foundContinueStatement:
           do{
+            checkDeadline(); // A loop whose body is empty does not execute any statement.
             for(const std::shared_ptr<Stmt>& statement : stmt->body){
               try{
                 execute(statement);
@@ -671,7 +1360,9 @@ class Interpreter : public ExprVisitor, public StmtVisitor{
       std::shared_ptr<Environment> previous = this->environment; // Stores the current environment that the interpreter is looking at inside this "previous" variable.
 
       try{
-        this->environment = std::make_shared<Environment>(previous); // Make the current environment that the interpreter is looking at be the environment of the block statement that is being visited.
+        if(stmt->needsScope){ // Loops that do not declare anything run in the current environment.
+          this->environment = std::make_shared<Environment>(previous); // Make the current environment that the interpreter is looking at be the environment of the block statement that is being visited.
+        }
         bool hasFoundContinueStatement = false;
         
         execute(stmt->initializer);
@@ -682,6 +1373,7 @@ class Interpreter : public ExprVisitor, public StmtVisitor{
           evaluate(stmt->increment);
         }
         while(isTruthy(evaluate(stmt->condition))){
+          checkDeadline(); // A loop whose body is empty does not execute any statement.
           for(const std::shared_ptr<Stmt>& statement : stmt->body){
             try{
               execute(statement);
@@ -760,6 +1452,29 @@ class Interpreter : public ExprVisitor, public StmtVisitor{
       return {};
     }
 
+    /**
+     * @brief Visits an Import Statement node of the Bleach AST and performs the associated actions. 
+     *
+     * This method is responsible for visiting an Import Statement node of the Bleach AST and performing the
+     * associated actions with this type of AST node: The native module is imported (see the 
+     * "importNativeModule" method), so its native functions are defined inside the global environment.
+     * 
+     * @param stmt: The node of the Bleach AST that is an Import Statement node.
+     * 
+     * @return Nothing ({}).
+     * 
+     * @note This method is an overridden version of the "visitImportStmt" method from the "StmtVisitor" struct.
+     */
+    std::any visitImportStmt(std::shared_ptr<Import> stmt) override{
+      try{
+        importNativeModule(std::any_cast<std::string>(stmt->path.literal));
+      }catch(const std::runtime_error& error){
+        throw BleachRuntimeError{stmt->path, error.what()};
+      }
+
+      return {};
+    }
+
     /**
      * @brief Visits a Print Statement node of the Bleach AST and performs the associated actions. 
      *
@@ -775,7 +1490,7 @@ class Interpreter : public ExprVisitor, public StmtVisitor{
     std::any visitPrintStmt(std::shared_ptr<Print> stmt) override{
       std::any value = evaluate(stmt->expression);
 
-      std::cout << stringify(value) << std::endl;
+      *outputStream << stringify(value) << std::endl;
 
       return {};
     }
@@ -846,10 +1561,13 @@ class Interpreter : public ExprVisitor, public StmtVisitor{
       std::shared_ptr<Environment> previous = this->environment; // Stores the current environment that the interpreter is looking at inside this "previous" variable.
 
       try{
-        this->environment = std::make_shared<Environment>(previous); // Make the current environment that the interpreter is looking at be the environment of the block statement that is being visited.
+        if(stmt->needsScope){ // Loops that do not declare anything run in the current environment.
+          this->environment = std::make_shared<Environment>(previous); // Make the current environment that the interpreter is looking at be the environment of the block statement that is being visited.
+        }
 
         foundContinueStatement:
           while(isTruthy(evaluate(stmt->condition))){
+            checkDeadline(); // A loop whose body is empty does not execute any statement.
             for(const std::shared_ptr<Stmt>& statement : stmt->body){
               try{
                 execute(statement);
@@ -883,14 +1601,36 @@ class Interpreter : public ExprVisitor, public StmtVisitor{
      * struct.
      */
     std::any visitAssignExpr(std::shared_ptr<Assign> expr) override{
-      std::any value = evaluate(expr->value);
+      std::any value;
+
+      if(expr->accumulates && expr->value->kind == ExprKind::BINARY){ // "name = name + other".
+        auto binary = std::static_pointer_cast<Binary>(expr->value);
+        std::any left = evaluate(binary->left);
+        std::any right = evaluate(binary->right);
 
-      auto elem = locals.find(expr);
-      if(elem != locals.end()){
-        int distance = elem->second;
-        environment->assignAt(expr->name, value, distance);
+        if(left.type() == typeid(std::shared_ptr<std::vector<std::any>>) && right.type() == typeid(std::shared_ptr<std::vector<std::any>>)){
+          const auto& list = *std::any_cast<std::shared_ptr<std::vector<std::any>>>(&left);
+          std::any current = evaluate(binary->left); // The right operand might have assigned another list to the variable.
+          const auto* held = std::any_cast<std::shared_ptr<std::vector<std::any>>>(&current);
+
+          if(held != nullptr && *held == list && list.use_count() == 3){ // The list is only referenced by the variable (and by "left" and "current"), so nobody else can tell that it's extended in place.
+            const auto& other = *std::any_cast<std::shared_ptr<std::vector<std::any>>>(&right);
+            list->insert(list->end(), other->begin(), other->end());
+            sideEffects++;
+
+            return left;
+          }
+        }
+
+        value = add(left, right, binary->op);
+      }else{
+        value = evaluate(expr->value);
+      }
+
+      if(expr->depth != -1){
+        environment->assignAt(expr->name, value, expr->depth);
       }else{
-        globals->assign(expr->name, value);
+        globals->assignSlot(expr->globalSlot, expr->name, value);
       }
 
       return value;
@@ -947,38 +1687,11 @@ class Interpreter : public ExprVisitor, public StmtVisitor{
 
           throw BleachRuntimeError{expr->op, "Operands must be 2 numbers or 2 strings."};
         case(TokenType::BANG_EQUAL):
-          return !isEqual(left, right);
+          return !isEqual(left, right, expr->op);
         case(TokenType::EQUAL_EQUAL):
-          return isEqual(left, right);
+          return isEqual(left, right, expr->op);
         case(TokenType::PLUS):
-          if(left.type() == typeid(double) && right.type() == typeid(double)){
-            return std::any_cast<double>(left) + std::any_cast<double>(right);
-          }
-          if(left.type() == typeid(std::string) && right.type() == typeid(std::string)){
-            return std::any_cast<std::string>(left) + std::any_cast<std::string>(right);
-          }
-          if(left.type() == typeid(double) && right.type() == typeid(std::string)){
-            return formatDouble(std::any_cast<double>(left)) + std::any_cast<std::string>(right);
-          }
-          if((left.type() == typeid(std::string) && right.type() == typeid(double))){
-            return std::any_cast<std::string>(left) + formatDouble(std::any_cast<double>(right));
-          }
-          if(left.type() == typeid(std::string) && right.type() == typeid(std::shared_ptr<BleachInstance>)){
-            return std::any_cast<std::string>(left) + std::any_cast<std::shared_ptr<BleachInstance>>(right)->toString(*this);
-          }
-          if(left.type() == typeid(std::shared_ptr<BleachInstance>) && right.type() == typeid(std::string)){
-            return std::any_cast<std::shared_ptr<BleachInstance>>(left)->toString(*this) + std::any_cast<std::string>(right);
-          }
-          if(left.type() == typeid(std::shared_ptr<std::vector<std::any>>) && right.type() == typeid(std::shared_ptr<std::vector<std::any>>)){
-            auto result = std::make_shared<std::vector<std::any>>();
-            auto vec1Ptr = std::any_cast<std::shared_ptr<std::vector<std::any>>>(left);
-            auto vec2Ptr = std::any_cast<std::shared_ptr<std::vector<std::any>>>(right);
-            result->insert(result->end(), vec1Ptr->begin(), vec1Ptr->end());
-            result->insert(result->end(), vec2Ptr->begin(), vec2Ptr->end());
-            return result;
-          }
-
-          throw BleachRuntimeError{expr->op, "Operands must be two numbers, or two strings, or two lists, or one number and one string."};
+          return add(left, right, expr->op);
         case(TokenType::MINUS):
           if(checkNumberOperands(left, right)){
             return std::any_cast<double>(left) - std::any_cast<double>(right); // If the cast does not work, it will throw a bad_cast error.
@@ -1013,6 +1726,43 @@ class Interpreter : public ExprVisitor, public StmtVisitor{
       return {};
     }
 
+    /**
+     * @brief Visits a Cached expression node of the Bleach AST and produces the corresponding value.
+     *
+     * This method is responsible for reusing the value of a common subexpression (see the Cached struct). The
+     * first occurrence of the subexpression always evaluates it and stores its value, unless a side effect has
+     * happened during such evaluation (see the "sideEffects" attribute) or the value is not safe to share. The
+     * next occurrences reuse such value only if it has been stored by the same call and no side effect has
+     * happened since then. Otherwise, they just evaluate the subexpression again.
+     * 
+     * @param expr: The node of the Bleach AST that is a Cached expression node.
+     * 
+     * @return The value of the common subexpression.
+     * 
+     * @note This method is an overridden version of the "visitCachedExpr" method from the "ExprVisitor" struct.
+     */
+    std::any visitCachedExpr(std::shared_ptr<Cached> expr) override{
+      CachedValue& cell = *expr->cell;
+
+      if(!expr->store && cell.valid && cell.epoch == sideEffects && cell.activation == activation){
+        return cell.value;
+      }
+
+      unsigned long epoch = sideEffects;
+      std::any value = evaluate(expr->expression);
+
+      if(expr->store){
+        const std::type_info& type = value.type();
+        bool copied = (type == typeid(double) || type == typeid(bool) || type == typeid(std::string) || type == typeid(std::nullptr_t));
+        cell.valid = (epoch == sideEffects && (copied || (expr->referenceSafe && type != typeid(std::shared_ptr<BleachNativeObject>))));
+        cell.value = cell.valid ? value : std::any{};
+        cell.epoch = epoch;
+        cell.activation = activation;
+      }
+
+      return value;
+    }
+
     /**
      * @brief Visits a Call expression node of the Bleach AST and produces the corresponding value. 
      *
@@ -1026,13 +1776,45 @@ class Interpreter : public ExprVisitor, public StmtVisitor{
      * @note This method is an overridden version of the "visitCallExpr" method from the "ExprVisitor" struct.
      */
     std::any visitCallExpr(std::shared_ptr<Call> expr) override{
-      std::any callee = evaluate(expr->callee); // First, the interpreter needs to evaluate the callee. Typically, this expression is just an identifier that looks up the function by its name, but it could be anything.
+      checkStack(expr->paren); // Every recursion of a Bleach program goes through a call.
+
+      if(expr->callee->kind == ExprKind::SUPER){ // Calls through the "super" keyword skip the creation of a bound method.
+        return callSuperMethod(std::static_pointer_cast<Super>(expr->callee), expr);
+      }
+
+      std::any callee;
+      if(expr->callee->kind == ExprKind::GET){ // Calls of the form "object.method(...)".
+        auto get = std::static_pointer_cast<Get>(expr->callee);
+        std::any object = evaluate(get->object);
 
-      std::vector<std::any> arguments;
-      for(const std::shared_ptr<Expr>& argument : expr->arguments){ // Second, the interpreter evaluates, in order, each expression inside the arguments list to produce its respective value.
-        arguments.push_back(evaluate(argument));
+        if(expr->indexedAccess && object.type() == typeid(std::shared_ptr<std::vector<std::any>>)){ // "list.getAt(i)" inside a loop whose induction variable "i" is known to hold a non-negative integer (see the Optimizer class).
+          const auto& list = *std::any_cast<std::shared_ptr<std::vector<std::any>>>(&object);
+          std::any index = evaluate(expr->arguments[0]);
+          const double* position = std::any_cast<double>(&index);
+          if(position != nullptr && *position >= 0 && *position < list->size()){ // The list might have been resized through another reference to it. Otherwise, the checks below report the error.
+            return (*list)[static_cast<std::size_t>(*position)];
+          }
+        }
+
+        if(object.type() == typeid(std::shared_ptr<BleachInstance>)){
+          auto instance = std::any_cast<std::shared_ptr<BleachInstance>>(object);
+          std::shared_ptr<BleachFunction> method = instance->findMethod(get->nameId); // The method of the class of the instance, unless it is shadowed by a field.
+          if(method != nullptr){
+            return callMethod(method, std::move(instance), expr); // The method is called directly on the instance, without creating a bound method.
+          }
+        }
+
+        callee = getProperty(object, get);
+      }else{
+        callee = evaluate(expr->callee); // First, the interpreter needs to evaluate the callee. Typically, this expression is just an identifier that looks up the function by its name, but it could be anything.
       }
 
+      ValueStack::Frame frame{valueStack, expr->arguments.size()}; // The arguments are evaluated directly onto the value stack of the interpreter, and they are released when the call returns.
+      for(std::size_t i = 0; i < expr->arguments.size(); i++){ // Second, the interpreter evaluates, in order, each expression inside the arguments list to produce its respective value.
+        frame[i] = evaluate(expr->arguments[i]);
+      }
+      ArgumentSpan arguments = frame.arguments();
+
       std::shared_ptr<BleachCallable> function;
 
       if(callee.type() == typeid(std::shared_ptr<BleachClass>)){
@@ -1040,101 +1822,28 @@ class Interpreter : public ExprVisitor, public StmtVisitor{
         if(arguments.size() != function->arity()){ // Checks whether the number of arguments passed in the class, function or method call is equal to its declared arity.
           throw BleachRuntimeError{expr->paren, "Expected " + std::to_string(function->arity()) + " arguments, but instead received " + std::to_string(arguments.size()) + "."};
         }
-        return function->call(*this, std::move(arguments)); // Finally, the interpreter calls an instance of a Bleach class.
+        return function->call(*this, arguments); // Finally, the interpreter calls an instance of a Bleach class.
       }
       else if(callee.type() == typeid(std::shared_ptr<BleachFunction>)){ // Third, the interpreter checks whether the callee is of type "BleachFuntion" because, if that's not the case, then an user cannot call it.
         function = std::any_cast<std::shared_ptr<BleachFunction>>(callee);  // Pointers in a "std::any" wrapper must be unwrapped before they can be cast.
         if(arguments.size() != function->arity()){ // Checks whether the number of arguments passed in the class, function or method call is equal to its declared arity.
           throw BleachRuntimeError{expr->paren, "Expected " + std::to_string(function->arity()) + " arguments, but instead received " + std::to_string(arguments.size()) + "."};
         }
-        return function->call(*this, std::move(arguments)); // Finally, the interpreter calls a Bleach function.
+        return function->call(*this, arguments); // Finally, the interpreter calls a Bleach function.
       }
       else if(callee.type() == typeid(std::shared_ptr<BleachLambdaFunction>)){
         function = std::any_cast<std::shared_ptr<BleachLambdaFunction>>(callee);  // Pointers in a "std::any" wrapper must be unwrapped before they can be cast.
         if(arguments.size() != function->arity()){ // Checks whether the number of arguments passed in the class, function or method call is equal to its declared arity.
           throw BleachRuntimeError{expr->paren, "Expected " + std::to_string(function->arity()) + " arguments, but instead received " + std::to_string(arguments.size()) + "."};
         }
-        return function->call(*this, std::move(arguments)); // Finally, the interpreter calls a Bleach lambda function.
-      }
-      else if(callee.type() == typeid(std::shared_ptr<NativeClock>)){
-        function = std::any_cast<std::shared_ptr<NativeClock>>(callee);
-
-        return function->call(*this, std::move(expr->paren), std::move(arguments)); // Finally, the interpreter calls a Bleach native function.
-      }
-      else if(callee.type() == typeid(std::shared_ptr<NativeReadLine>)){
-        function = std::any_cast<std::shared_ptr<NativeReadLine>>(callee);
-
-        return function->call(*this, std::move(expr->paren), std::move(arguments)); // Finally, the interpreter calls a Bleach native function.
-      }
-      else if(callee.type() == typeid(std::shared_ptr<NativePrint>)){
-        function = std::any_cast<std::shared_ptr<NativePrint>>(callee);
-
-        return function->call(*this, std::move(expr->paren), std::move(arguments)); // Finally, the interpreter calls a Bleach native function.
-      }
-      else if(callee.type() == typeid(std::shared_ptr<NativeFileRead>)){
-        function = std::any_cast<std::shared_ptr<NativeFileRead>>(callee);
-
-        return function->call(*this, std::move(expr->paren), std::move(arguments)); // Finally, the interpreter calls a Bleach native function.
-      }
-      else if(callee.type() == typeid(std::shared_ptr<NativeFileWrite>)){
-        function = std::any_cast<std::shared_ptr<NativeFileWrite>>(callee);
-
-        return function->call(*this, std::move(expr->paren), std::move(arguments)); // Finally, the interpreter calls a Bleach native function.
-      }
-      else if(callee.type() == typeid(std::shared_ptr<NativeAbsoluteValue>)){
-        function = std::any_cast<std::shared_ptr<NativeAbsoluteValue>>(callee);
-
-        return function->call(*this, std::move(expr->paren), std::move(arguments)); // Finally, the interpreter calls a Bleach native function.
-      }
-      else if(callee.type() == typeid(std::shared_ptr<NativeCeil>)){
-        function = std::any_cast<std::shared_ptr<NativeCeil>>(callee);
-
-        return function->call(*this, std::move(expr->paren), std::move(arguments)); // Finally, the interpreter calls a Bleach native function.
-      }
-      else if(callee.type() == typeid(std::shared_ptr<NativeFloor>)){
-        function = std::any_cast<std::shared_ptr<NativeFloor>>(callee);
-
-        return function->call(*this, std::move(expr->paren), std::move(arguments)); // Finally, the interpreter calls a Bleach native function.
+        return function->call(*this, arguments); // Finally, the interpreter calls a Bleach lambda function.
       }
-      else if(callee.type() == typeid(std::shared_ptr<NativeExponentiation>)){
-        function = std::any_cast<std::shared_ptr<NativeExponentiation>>(callee);
-
-        return function->call(*this, std::move(expr->paren), std::move(arguments)); // Finally, the interpreter calls a Bleach native function.
-      }
-      else if(callee.type() == typeid(std::shared_ptr<NativeLogarithm>)){
-        function = std::any_cast<std::shared_ptr<NativeLogarithm>>(callee);
-
-        return function->call(*this, std::move(expr->paren), std::move(arguments)); // Finally, the interpreter calls a Bleach native function.
-      }
-      else if(callee.type() == typeid(std::shared_ptr<NativeSquareRoot>)){
-        function = std::any_cast<std::shared_ptr<NativeSquareRoot>>(callee);
-
-        return function->call(*this, std::move(expr->paren), std::move(arguments)); // Finally, the interpreter calls a Bleach native function.
-      }
-      else if(callee.type() == typeid(std::shared_ptr<NativeRandom>)){
-        function = std::any_cast<std::shared_ptr<NativeRandom>>(callee);
-
-        return function->call(*this, std::move(expr->paren), std::move(arguments)); // Finally, the interpreter calls a Bleach native function.
-      }
-      else if(callee.type() == typeid(std::shared_ptr<NativeOrd>)){
-        function = std::any_cast<std::shared_ptr<NativeOrd>>(callee);
-
-        return function->call(*this, std::move(expr->paren), std::move(arguments)); // Finally, the interpreter calls a Bleach native function.
-      }
-      else if(callee.type() == typeid(std::shared_ptr<NativeStringToNumber>)){
-        function = std::any_cast<std::shared_ptr<NativeStringToNumber>>(callee);
-
-        return function->call(*this, std::move(expr->paren), std::move(arguments)); // Finally, the interpreter calls a Bleach native function.
-      }
-      else if(callee.type() == typeid(std::shared_ptr<NativeStringToBool>)){
-        function = std::any_cast<std::shared_ptr<NativeStringToBool>>(callee);
-
-        return function->call(*this, std::move(expr->paren), std::move(arguments)); // Finally, the interpreter calls a Bleach native function.
-      }
-      else if(callee.type() == typeid(std::shared_ptr<NativeStringToNil>)){
-        function = std::any_cast<std::shared_ptr<NativeStringToNil>>(callee);
-
-        return function->call(*this, std::move(expr->paren), std::move(arguments)); // Finally, the interpreter calls a Bleach native function.
+      else if(callee.type() == typeid(std::shared_ptr<BleachNativeFunction>)){ // Every native function shares this type (see the BleachNativeFunction class).
+        const auto& native = std::any_cast<const std::shared_ptr<BleachNativeFunction>&>(callee);
+        if(!native->isPure()){
+          sideEffects++;
+        }
+        return native->invoke(*this, expr->paren, arguments); // Finally, the interpreter calls a Bleach native function.
       }
       // Methods from 'list' and/or 'str' types:
       // "str" method: "find".
@@ -1220,6 +1929,7 @@ class Interpreter : public ExprVisitor, public StmtVisitor{
         }
 
         std::any value = arguments[0];
+        sideEffects++;
         listMethod(value);
 
         return nullptr;
@@ -1253,6 +1963,7 @@ class Interpreter : public ExprVisitor, public StmtVisitor{
           throw BleachRuntimeError{expr->paren, "Expected 0 arguments for the 'clear' method."};
         }
 
+        sideEffects++;
         listMethod();
 
         return nullptr;
@@ -1265,6 +1976,7 @@ class Interpreter : public ExprVisitor, public StmtVisitor{
           throw BleachRuntimeError{expr->paren, "Expected 0 arguments for the 'pop' method."};
         }
 
+        sideEffects++;
         return listMethod();
       }
       // "list" method: "setAt".
@@ -1287,6 +1999,7 @@ class Interpreter : public ExprVisitor, public StmtVisitor{
         int index = std::floor(indexObject);
         std::any value = arguments[1];
 
+        sideEffects++;
         listMethod(index, value);
 
         return nullptr;
@@ -1311,11 +2024,70 @@ class Interpreter : public ExprVisitor, public StmtVisitor{
         int amount = std::floor(amountObject);
         std::any value = arguments[0];
 
+        sideEffects++;
         listMethod(value, amount);
 
         return nullptr;
       }
 
+      // "list" method: "concat".
+      else if(callee.type() == typeid(std::function<std::shared_ptr<std::vector<std::any>>(std::shared_ptr<std::vector<std::any>>)>)){
+        auto listMethod = std::any_cast<std::function<std::shared_ptr<std::vector<std::any>>(std::shared_ptr<std::vector<std::any>>)>>(callee);
+
+        if(arguments.size() != 1){
+          throw BleachRuntimeError{expr->paren, "Expected 1 arguments for the 'concat' method."};
+        }
+        if(arguments[0].type() != typeid(std::shared_ptr<std::vector<std::any>>)){
+          throw BleachRuntimeError{expr->paren, "Expected 1 argument of type 'list' for the 'concat' method."};
+        }
+
+        return listMethod(std::any_cast<std::shared_ptr<std::vector<std::any>>>(arguments[0]));
+      }
+      // "list" method: "extend".
+      else if(callee.type() == typeid(std::function<void(std::shared_ptr<std::vector<std::any>>)>)){
+        auto listMethod = std::any_cast<std::function<void(std::shared_ptr<std::vector<std::any>>)>>(callee);
+
+        if(arguments.size() != 1){
+          throw BleachRuntimeError{expr->paren, "Expected 1 arguments for the 'extend' method."};
+        }
+        if(arguments[0].type() != typeid(std::shared_ptr<std::vector<std::any>>)){
+          throw BleachRuntimeError{expr->paren, "Expected 1 argument of type 'list' for the 'extend' method."};
+        }
+
+        sideEffects++;
+        listMethod(std::any_cast<std::shared_ptr<std::vector<std::any>>>(arguments[0]));
+
+        return nullptr;
+      }
+      // "list" method: "slice".
+      else if(callee.type() == typeid(std::function<std::shared_ptr<std::vector<std::any>>(int, int)>)){
+        auto listMethod = std::any_cast<std::function<std::shared_ptr<std::vector<std::any>>(int, int)>>(callee);
+
+        if(arguments.size() != 2){
+          throw BleachRuntimeError{expr->paren, "Expected 2 arguments for the 'slice' method."};
+        }
+        if(arguments[0].type() != typeid(double) || arguments[1].type() != typeid(double)){
+          throw BleachRuntimeError{expr->paren, "Expected 2 arguments of type 'num' for the 'slice' method."};
+        }
+
+        double start = std::any_cast<double>(arguments[0]);
+        double end = std::any_cast<double>(arguments[1]);
+
+        if(start < 0 || end < 0){
+          throw BleachRuntimeError{expr->paren, "The values of both arguments cannot be negative for the 'slice' method."};
+        }
+        if(std::floor(start) != start || std::floor(end) != end){
+          throw BleachRuntimeError{expr->paren, "The value of both arguments must be integers of type 'num' for the 'slice' method."};
+        }
+        if(end > std::numeric_limits<int>::max()){
+          end = std::numeric_limits<int>::max(); // Such range is out of bounds anyway, which is reported by the method itself.
+        }
+        if(start > end){
+          throw BleachRuntimeError{expr->paren, "The value of the first argument cannot be larger than the second argument for the 'slice' method."};
+        }
+
+        return listMethod(static_cast<int>(start), static_cast<int>(end));
+      }
 
       throw BleachRuntimeError{expr->paren, "Can only call classes, functions, lambda functions, methods and native functions."};
     }
@@ -1333,10 +2105,25 @@ class Interpreter : public ExprVisitor, public StmtVisitor{
      * @note This method is an overridden version of the "visitGetExpr" method from the "ExprVisitor" struct.
      */
     std::any visitGetExpr(std::shared_ptr<Get> expr) override{
-      std::any object = evaluate(expr->object);
+      return getProperty(evaluate(expr->object), expr);
+    }
 
+    /**
+     * @brief Returns the property (field or method) of an already evaluated object that a Get expression node 
+     * refers to. 
+     *
+     * This method is responsible for performing the work of the "visitGetExpr" method once the object of the Get
+     * expression node has been evaluated. It's also used by the "visitCallExpr" method, which evaluates the 
+     * object itself in order to call methods of instances directly.
+     * 
+     * @param object: The value produced by the evaluation of the object of the Get expression node.
+     * @param expr: The node of the Bleach AST that is a Get Expression node.
+     * 
+     * @return The value of the property.
+     */
+    std::any getProperty(const std::any& object, const std::shared_ptr<Get>& expr){
       if(object.type() == typeid(std::shared_ptr<BleachInstance>)){
-        return std::any_cast<std::shared_ptr<BleachInstance>>(object)->get(expr->name);
+        return std::any_cast<std::shared_ptr<BleachInstance>>(object)->get(expr->name, expr->nameId);
       }else if(object.type() == typeid(std::string)){
         std::string str = std::any_cast<std::string>(object);
         Token methodToken = expr->name;
@@ -1402,10 +2189,28 @@ class Interpreter : public ExprVisitor, public StmtVisitor{
             vecPtr->clear();
             return;
           });
+        }else if(methodName == "concat"){
+          return std::function<std::shared_ptr<std::vector<std::any>>(std::shared_ptr<std::vector<std::any>>)>([vecPtr](const std::shared_ptr<std::vector<std::any>>& other){
+            auto result = std::make_shared<std::vector<std::any>>();
+            result->reserve(vecPtr->size() + other->size());
+            result->insert(result->end(), vecPtr->begin(), vecPtr->end());
+            result->insert(result->end(), other->begin(), other->end());
+            return result;
+          });
         }else if(methodName == "empty"){ // DONE
           return std::function<bool()>([vecPtr](){
             return vecPtr->empty();
           });
+        }else if(methodName == "extend"){
+          return std::function<void(std::shared_ptr<std::vector<std::any>>)>([vecPtr](const std::shared_ptr<std::vector<std::any>>& other){
+            if(other == vecPtr){ // The elements are copied first, since growing the list invalidates the range being inserted.
+              std::vector<std::any> elements = *other;
+              vecPtr->insert(vecPtr->end(), elements.begin(), elements.end());
+              return;
+            }
+            vecPtr->insert(vecPtr->end(), other->begin(), other->end());
+            return;
+          });
         }else if(methodName == "fill"){ // DONE
           return std::function<void(std::any, int)>([vecPtr, methodToken](std::any value, int size){
             if(size < 0){
@@ -1440,6 +2245,13 @@ class Interpreter : public ExprVisitor, public StmtVisitor{
             (*vecPtr)[index] = value;
             return;
           });
+        }else if(methodName == "slice"){
+          return std::function<std::shared_ptr<std::vector<std::any>>(int, int)>([vecPtr, methodToken](int start, int end){
+            if(start > end || end > vecPtr->size()){
+              throw BleachRuntimeError{methodToken, "Index out of bounds. The value of 'list' type has size equal " + std::to_string(vecPtr->size()) + ", but the range provided was [" + std::to_string(start) + ", " + std::to_string(end) + ")."};
+            }
+            return std::make_shared<std::vector<std::any>>(vecPtr->begin() + start, vecPtr->begin() + end);
+          });
         }else if(methodName == "size"){ // DONE
           return std::function<double()>([vecPtr](){
             return static_cast<double>(vecPtr->size());
@@ -1447,9 +2259,15 @@ class Interpreter : public ExprVisitor, public StmtVisitor{
         }
 
         throw BleachRuntimeError{expr->name, "Undefined method of the 'list' type."};
+      }else if(object.type() == typeid(std::shared_ptr<BleachNativeObject>)){ // Foreign libraries and the objects created by native modules.
+        try{
+          return std::any_cast<const std::shared_ptr<BleachNativeObject>&>(object)->getProperty(expr->name.lexeme);
+        }catch(const NativeFunctionError& error){
+          throw BleachRuntimeError{expr->name, error.what()};
+        }
       }
 
-      throw BleachRuntimeError{expr->name, "Only instances, lists or strings have properties."};
+      throw BleachRuntimeError{expr->name, "Only instances, lists, strings or native objects have properties."};
     }
 
     /**
@@ -1563,7 +2381,7 @@ class Interpreter : public ExprVisitor, public StmtVisitor{
      * @note This method is an overridden version of the "visitSelfExpr" method from the "ExprVisitor" struct.
      */
     std::any visitSelfExpr(std::shared_ptr<Self> expr) override{
-      return lookUpVariable(expr->keyword, expr);
+      return lookUpVariable(expr->keyword, expr->depth, -1); // "self" is always resolved as a local variable.
     }
 
     /**
@@ -1586,7 +2404,8 @@ class Interpreter : public ExprVisitor, public StmtVisitor{
       }
 
       std::any value = evaluate(expr->value);
-      std::any_cast<std::shared_ptr<BleachInstance>>(object)->set(expr->name, value);
+      sideEffects++;
+      std::any_cast<std::shared_ptr<BleachInstance>>(object)->set(expr->name, expr->nameId, value);
 
       return value;
     }
@@ -1604,17 +2423,11 @@ class Interpreter : public ExprVisitor, public StmtVisitor{
      * @note This method is an overridden version of the "visitSuperExpr" method from the "ExprVisitor" struct.
      */
     std::any visitSuperExpr(std::shared_ptr<Super> expr) override{
-      int distance = locals[expr];
+      int distance = expr->depth; // The "super" keyword is always resolved as a local variable.
 
-      auto superclass = std::any_cast<std::shared_ptr<BleachClass>>(environment->getAt("super", distance));
+      std::shared_ptr<BleachFunction> method = findSuperMethod(expr, distance);
       auto object = std::any_cast<std::shared_ptr<BleachInstance>>(environment->getAt("self", distance - 1));
 
-      std::shared_ptr<BleachFunction> method = superclass->findMethod(expr->method.lexeme);
-
-      if(method == nullptr){
-        throw BleachRuntimeError{expr->method, "Undefined property (field or method):" + expr->method.lexeme + "."};
-      }
-
       return method->bind(object);
     }
 
@@ -1683,6 +2496,26 @@ class Interpreter : public ExprVisitor, public StmtVisitor{
      * struct.
      */
     std::any visitVariableExpr(std::shared_ptr<Variable> expr) override{
-      return lookUpVariable(expr->name, expr);
+      return lookUpVariable(expr->name, expr->depth, expr->globalSlot);
     }
 };
+
+/**
+ * @brief Implements the "std::utils::hash" native function: Returns the hash of its only argument (see the 
+ * "hash" method of the Interpreter class) as a number. The hash is truncated to 53 bits, so every hash is 
+ * represented exactly by a number.
+ *
+ * @param interpreter: The instance of the Interpreter class that runs the program.
+ * @param paren: The closing parenthesis of the call.
+ * @param arguments: The arguments of the call.
+ *
+ * @return The hash of the argument.
+**/
+inline std::any NativeHash::invoke(Interpreter& interpreter, const Token& paren, ArgumentSpan arguments){
+  checkArity(paren, arguments);
+
+  std::vector<const std::vector<std::any>*> lists;
+  std::size_t hash = interpreter.hash(arguments[0], location(paren), lists);
+
+  return static_cast<double>(hash & ((1ull << 53) - 1));
+}
@@ -34,10 +34,14 @@ class Lexer{
     int line = 1; /**< Variable that holds the information about which line the lexer is currently at with respect to the source code file. It helps the lexer to generate tokens that know their location in the source code file. */
     std::set<std::string> nativeFunctions = { /** Variable that stores the names of Bleach native functions. */
       "std::chrono::clock", 
+      "std::ffi::load",
+      "std::functools::memoize",
       "std::io::readLine", "std::io::print", "std::io::fileRead", "std::io::fileWrite",
       "std::math::abs", "std::math::ceil", "std::math::floor", "std::math::log", "std::math::pow", "std::math::sqrt",
       "std::random::random",
-      "std::utils::ord", "std::utils::strToNum", "std::utils::strToBool", "std::utils::strToNil"
+      "std::runtime::snapshot",
+      "std::serial::dump", "std::serial::load", "std::serial::dumpFile", "std::serial::loadFile",
+      "std::utils::hash", "std::utils::ord", "std::utils::strToNum", "std::utils::strToBool", "std::utils::strToNil"
     };
     std::map<std::string, TokenType> keywords = { /** Variable that maps string values of Bleach keywords to its respective TokenType enum values. */
       {"and",           TokenType::AND},
@@ -51,6 +55,7 @@ class Lexer{
       {"for",           TokenType::FOR},
       {"function",      TokenType::FUNCTION},
       {"if",            TokenType::IF},
+      {"import",        TokenType::IMPORT},
       {"inherits",      TokenType::INHERITS},
       {"lambda",        TokenType::LAMBDA},
       {"let",           TokenType::LET},
@@ -269,6 +274,39 @@ class Lexer{
       return;
     }
 
+    /**
+     * @brief Checks whether an identifier that contains the ':' character can be the name of a native function
+     * defined by a native module (see the "import native" statement). Such names are made of identifiers
+     * separated by "::" (e.g. "vec::dot"), and the "std" namespace is reserved to the standard library.
+     * 
+     * @param lexeme: The identifier.
+     * 
+     * @return A boolean that signals whether the identifier is a valid name for such native function.
+    **/
+    bool isModuleNativeName(const std::string& lexeme){
+      if(lexeme.rfind("std::", 0) == 0){
+        return false;
+      }
+
+      std::size_t segmentStart = 0;
+      while(true){
+        std::size_t separator = lexeme.find(':', segmentStart);
+        if(separator == segmentStart){ // Empty segment (e.g. "::dot" or "vec:::dot").
+          return false;
+        }
+        if(separator == std::string::npos){
+          return true;
+        }
+        if(separator + 1 >= lexeme.size() || lexeme[separator + 1] != ':'){ // A single ':' character.
+          return false;
+        }
+        segmentStart = separator + 2;
+        if(segmentStart == lexeme.size()){ // Trailing "::".
+          return false;
+        }
+      }
+    }
+
     /**
      * @brief Consumes an identifier, generates its respective token and adds it to the token sequence that is
      * being generated by the lexer. After its execution, the 'current' variable is pointing to the character
@@ -290,7 +328,7 @@ class Lexer{
       std::string lexeme = std::string{sourceCode.substr(start, current - start)};
       if(keywords.find(lexeme) != keywords.end()){
         type = keywords[lexeme];
-      }else if(lexeme.find(":") != std::string::npos && nativeFunctions.find(lexeme) == nativeFunctions.end()){
+      }else if(lexeme.find(":") != std::string::npos && nativeFunctions.find(lexeme) == nativeFunctions.end() && !isModuleNativeName(lexeme)){
         error(line, "Cannot use the ':' character if not in a Bleach native function call");
       }
       else{
@@ -1,3 +1,4 @@
+#include <cstdlib>
 #include <cstring>
 #include <filesystem>
 #include <fstream>
@@ -5,11 +6,17 @@
 #include <string>
 #include <vector>
 
+#include <unistd.h>
+
 #include "error/Error.hpp"
 #include "interpreter/Interpreter.hpp"
 #include "lexer/Lexer.hpp"
 #include "parser/Parser.hpp"
 #include "resolver/Resolver.hpp"
+#include "runner/Batch.hpp"
+#include "runner/ForkServer.hpp"
+#include "runner/Runner.hpp"
+#include "runner/Server.hpp"
 
 // It's not good practice to include .cpp files, but in our case it allows us to lay out the files similarly to
 // the Java code while avoiding circular dependencies.
@@ -17,6 +24,7 @@
 #include "./utils/BleachFunction.cpp"
 #include "./utils/BleachInstance.cpp"
 #include "./utils/BleachLambdaFunction.cpp"
+#include "./utils/Snapshot.cpp"
 
 
 Interpreter interpreter{}; /* Variable that represents the instance of the BLEACH Interpreter. This variable must be declared as global because, so sucessful calls to the 'run' function inside a REPL session reuse the same Interpreter instance. Remember that things must persist through a REPL session. */
@@ -25,10 +33,9 @@ Interpreter interpreter{}; /* Variable that represents the instance of the BLEAC
  * @brief Receives a path to a file (absolute or relative), checks whether the file exists and if it is a Bleach
  * file, extracts all of its content and stores it in a string. Then, return such string.
  * 
- * This function is responsible for receiving the absolute of relative file path of a supposed Bleach file. 
- * Then, it checks whether the file exists and whether it is, indeeed, a Bleach file. Then, it tries to open 
- * the said file. If everything went okay, then this function extracts the whole content of the file, stores it 
- * inside a string (std::string) variable called "fileContent" and returns it.
+ * This function is responsible for receiving the absolute of relative file path of a supposed Bleach file and 
+ * reading it through the "readSourceFile" function. If the file cannot be read, the BLEACH Interpreter exits 
+ * with the status 74.
  * 
  * @param filePath A string (std::string_view) that stores the absolute or relative file path to the Bleach file
  * that will be interpreted.
@@ -37,24 +44,10 @@ Interpreter interpreter{}; /* Variable that represents the instance of the BLEAC
  * provided file path.
 **/
 std::string readFile(std::string_view filePath){
-  std::filesystem::path path{filePath};
-  if(path.extension() != ".bch"){
-    std::cerr << RED << "[BLEACH Interpreter Error]: Cannot execute the provided file because it's not a Bleach file: '" << filePath << "'. " << WHITE << std::endl;
-    std::exit(74); 
-  }
-
-  std::ifstream file{filePath.data(), std::ios::in | std::ios::binary | std::ios::ate};
-  if(!file){
-    std::cerr << RED << "[BLEACH Interpreter Error]: Failed to open file '" << filePath << "': " << std::strerror(errno) << WHITE << std::endl;
-    std::exit(74); 
-  }
-
   std::string fileContent;
-  fileContent.resize(file.tellg());
-
-  file.seekg(0, std::ios::beg);
-  file.read(fileContent.data(), fileContent.size());
-  file.close();
+  if(!readSourceFile(filePath, fileContent)){
+    std::exit(74);
+  }
 
   return fileContent;
 }
@@ -63,45 +56,15 @@ std::string readFile(std::string_view filePath){
  * @brief This function lexes, parse, analyze and execute/interpret the source code present inside a Bleach file
  * provided in the "sourceCode" variable.
  * 
- * This function is responsible for instantiating (step-by-step) the lexer, parser, static analyzer and 
- * interpreter/runtime of the Bleach language. This function will perform each step of the interpreter pipeline
- * and, if an error is found during one of these steps, then the whole process will be interrupted.
+ * This function is responsible for running the interpreter pipeline (see the "runSource" function) with the 
+ * instance of the Interpreter class that is shared by the whole session.
  * 
  * @param sourceCode A string (std::string_view) that contains the source code of a Bleach file.
  * 
  * @return Nothing (void).
 **/
 void run(std::string_view sourceCode){
-  /* First Step: Lexing */
-  Lexer lexer{sourceCode};
-  std::vector<Token> tokens = lexer.lexTokens();
-
-  if(hadError){
-    return;
-  }
-
-  // for(const Token& token : tokens){
-  //   std::cout << token.toString() << std::endl;
-  // }
-
-  /* Second Step: Parsing */
-  Parser parser{tokens};
-  std::vector<std::shared_ptr<Stmt>> statements = parser.parse();
-
-  if(hadError){
-    return;
-  }
-
-  /* Third Step: Resolving */
-  Resolver resolver{interpreter};
-  resolver.resolve(statements);
-
-  if(hadError){
-    return;
-  }
-
-  /* Fourth Step: Interpreting */
-  interpreter.interpret(statements);
+  runSource(interpreter, sourceCode);
 
   return;
 }
@@ -134,6 +97,54 @@ void runFile(std::string_view filePath){
   return;
 }
 
+/**
+ * @brief Restores a snapshot (taken by the "std::runtime::snapshot" native function) and, then, executes a 
+ * Bleach file on top of the restored state.
+ * 
+ * This function is responsible for restoring the global variables (and every value reachable from them) stored
+ * inside the snapshot into the instance of the Interpreter class of the session, so the Bleach file does not 
+ * need to build them again. If the snapshot cannot be restored, the BLEACH Interpreter exits with the status 74.
+ * 
+ * @param snapshotPath A string (std::string_view) that represents the path to the snapshot file.
+ * @param filePath A string (std::string_view) that represents the absolute or relative path to a Bleach file.
+ * 
+ * @return Nothing (void).
+**/
+void runRestoredFile(std::string_view snapshotPath, std::string_view filePath){
+  SnapshotReader reader{interpreter};
+  if(!reader.restore(std::string{snapshotPath})){
+    std::exit(74);
+  }
+  runFile(filePath);
+
+  return;
+}
+
+/**
+ * @brief Prints a report of the memory used by the current REPL session.
+ * 
+ * This function is responsible for answering the ":mem" command of the REPL. It reports how many AST nodes are
+ * still alive (the ones of previous inputs are released once no function, lambda or class refers to them), how
+ * many global variables are defined and the resident set size of the process (read from "/proc/self/statm", 
+ * which is only available on Linux).
+ * 
+ * @return Nothing (void).
+**/
+void reportMemoryUsage(){
+  std::cout << "AST nodes alive: " << Expr::liveNodes + Stmt::liveNodes << " (" << Expr::liveNodes << " expressions, " << Stmt::liveNodes << " statements)" << std::endl;
+  std::cout << "Global variables: " << interpreter.globals->definedSlots() << " defined, " << interpreter.globals->slotCount() << " slots" << std::endl;
+
+  std::ifstream statm{"/proc/self/statm"};
+  long totalPages = 0, residentPages = 0;
+  if(statm >> totalPages >> residentPages){
+    std::cout << "Resident set size: " << residentPages * (sysconf(_SC_PAGESIZE) / 1024) << " KiB" << std::endl;
+  }else{
+    std::cout << "Resident set size: unavailable" << std::endl;
+  }
+
+  return;
+}
+
 /**
  * @brief Starts up the BLEACH Interpreter in the "REPL Mode".
  * 
@@ -141,6 +152,9 @@ void runFile(std::string_view filePath){
  * enters an infinite loop, where it expects Bleach statements. When a statement is provided, it is read by
  * the interpreter, then evaluated (interpreted) and the loop starts again. To interrupt the BLEACH Interpreter
  * in the "REPL Mode", just press Ctrl+C or Ctrl+D.
+ * Each input is resolved against the global scope of the session (the slots of the global environment), and its
+ * AST is released as soon as nothing that is still alive (a function, a lambda or a class) refers to it. The 
+ * ":mem" command reports the memory used by the session.
  * 
  * @return Nothing (void).
 **/
@@ -149,6 +163,10 @@ void runPrompt() {
     std::cout << "> ";
     std::string line;
     if (!std::getline(std::cin, line)) break;
+    if (line == ":mem") {
+      reportMemoryUsage();
+      continue;
+    }
     run(line);
     hadError = false;
   }
@@ -161,12 +179,20 @@ void runPrompt() {
  * depending on whether or not you have passed parameters to the executable when asking the OS to run it.
  * 
  * This function is responsible for being the entry point of the BLEACH interpreter. It starts up the interpreter
- * in two possible modes ("File Mode" or "REPL Mode").
+ * in five possible modes ("File Mode", "REPL Mode", "Batch Mode", "Server Mode" or "Fork Server Mode").
  * To start up the interpreter in the "File Mode", you must compile the project using the provided Makefile and
  * then provide the absolute or relative path to the Bleach file you want to interpret as the only argument when
  * executing the generated binary.
  * To start up the interpreter in the "REPL Mode", you must compile the project using the provided Makefile and
  * then just execute the generated binary.
+ * To start up the interpreter in the "Batch Mode", pass "--batch" followed by the Bleach files (or manifests)
+ * that must be run (see the "runBatch" function).
+ * To start up the interpreter in the "Server Mode", pass "--serve" followed by the path of the Unix domain 
+ * socket on which requests are accepted and, optionally, by "--timeout SECONDS" (see the Server class).
+ * To start up the interpreter in the "Fork Server Mode", pass "--fork-server" followed by the path of the Unix
+ * domain socket and by the Bleach files that can be requested (see the "runForkServer" function).
+ * Finally, "--restore snapshot_file file_name.bch" runs a Bleach file on top of the state stored inside a 
+ * snapshot (see the "runRestoredFile" function).
  * 
  * @param argc: The int that represents the number of arguments passed when running the executable.
  * @param argv: The array of strings (char* []) that stores the values of each of the passed arguments.
@@ -174,15 +200,28 @@ void runPrompt() {
  * @return An int that denotes whether the 'main' function executed without problems (0) or with problems (a number different from 0).
 **/
 int main(int argc, char* argv[]){
-  if(argc == 2){
+  if(argc >= 2 && std::string_view{argv[1]} == "--batch"){
+    return runBatch(std::vector<std::string>(argv + 2, argv + argc));
+  }else if((argc == 3 || (argc == 5 && std::string_view{argv[3]} == "--timeout")) && std::string_view{argv[1]} == "--serve"){
+    unsigned long seconds = (argc == 5) ? std::strtoul(argv[4], nullptr, 10) : 0;
+    return Server{argv[2], std::chrono::seconds{seconds > 0 ? seconds : 10}}.serve(); // Programs run for up to 10 seconds by default.
+  }else if(argc >= 3 && std::string_view{argv[1]} == "--fork-server"){
+    return runForkServer(std::vector<std::string>(argv + 2, argv + argc));
+  }else if(argc == 4 && std::string_view{argv[1]} == "--restore"){
+    runRestoredFile(argv[2], argv[3]);
+  }else if(argc == 2){
     runFile(argv[1]);
   }else if(argc == 1){
     runPrompt();
   }else{
     std::cout << RED << "[BLEACH Interpreter Error] Incorrect use of the interpreter." << std::endl;
-    std::cout << "There are two options for you to run the interprter:" << std::endl;
+    std::cout << "There are six options for you to run the interprter:" << std::endl;
     std::cout << " 1) Starting up the interactive interpreter through the command: ./BleachInterpreter" << std::endl;
-    std::cout << " 2) Passing a Bleach file to the interpreter so it can execute it through the command: ./BleachInterpreter file_name.bah" << WHITE << std::endl;
+    std::cout << " 2) Passing a Bleach file to the interpreter so it can execute it through the command: ./BleachInterpreter file_name.bah" << std::endl;
+    std::cout << " 3) Running many Bleach files in a single process through the command: ./BleachInterpreter --batch [--jobs N] [--out DIR] file_name.bch ... @manifest.txt" << std::endl;
+    std::cout << " 4) Serving requests to run Bleach programs over a Unix domain socket through the command: ./BleachInterpreter --serve path/to.sock [--timeout SECONDS]" << std::endl;
+    std::cout << " 5) Running prepared Bleach files in isolated child processes on request through the command: ./BleachInterpreter --fork-server path/to.sock [--cpu SECONDS] [--timeout SECONDS] [--memory MEGABYTES] file_name.bch ..." << std::endl;
+    std::cout << " 6) Running a Bleach file on top of the state stored inside a snapshot through the command: ./BleachInterpreter --restore snapshot_file file_name.bch" << WHITE << std::endl;
     std::exit(64);
   }
 
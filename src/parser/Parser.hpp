@@ -2,7 +2,6 @@
 
 #include <cassert>
 #include <memory>
-#include <set>
 #include <stdexcept>
 #include <string>
 #include <string_view>
@@ -38,13 +37,6 @@ class Parser{
     };
     int current = 0; /**< Variable that points to the next token that has not been consumed yet by the parser. */
     const std::vector<Token>& tokens; /**< Variable that represents the sequence of tokens received by the parser from the lexer. Such sequence will be parsed into an AST. */
-    std::set<std::string> nativeFunctions = { /** Variable that stores the names of Bleach native functions. */
-      "std::chrono::clock", 
-      "std::io::readLine", "std::io::print", "std::io::fileRead", "std::io::fileWrite",
-      "std::math::abs", "std::math::ceil", "std::math::floor", "std::math::log", "std::math::pow", "std::math::sqrt",
-      "std::random::random",
-      "std::utils::ord", "std::utils::strToNum", "std::utils::strToBool", "std::utils::strToNil"
-    };
 
     /**
      * @brief Returns the token that has just been consumed by the parser.
@@ -145,6 +137,7 @@ class Parser{
           case(TokenType::FOR):
           case(TokenType::FUNCTION):
           case(TokenType::IF):
+          case(TokenType::IMPORT):
           case(TokenType::LET):
           case(TokenType::PRINT):
           case(TokenType::RETURN):
@@ -269,6 +262,9 @@ class Parser{
         if(match(TokenType::IF)){
           return ifStatement();
         }
+        if(match(TokenType::IMPORT)){
+          return importStatement();
+        }
         if(match(TokenType::LEFT_BRACE)){
           return std::make_shared<Block>(block());
         }
@@ -527,6 +523,30 @@ class Parser{
       return std::make_shared<If>(ifCondition, ifBranch, elifConditions, elifBranches, elseBranch);
     }
 
+    /**
+     * @brief Represents the "importStmt" rule inside the CFG of the Bleach language.
+     *
+     * This method is responsible for representing the "importStmt" rule from the Context-Free Grammar of 
+     * the Bleach language. To understand better what the method is doing, take a look at Bleach's CFG.
+     * 
+     * @return An instance of the Stmt struct representing an Abstract Syntax Tree (AST) node of the Bleach 
+     * language for this rule.
+     * 
+     * @note: "native" is not a keyword of the Bleach language. It's only recognized right after the "import"
+     * keyword, so it can still be used as a name anywhere else.
+    **/
+    std::shared_ptr<Stmt> importStatement(){
+      Token keyword = previous();
+      Token kind = consume(TokenType::IDENTIFIER, "Expected 'native' after the 'import' keyword");
+      if(kind.lexeme != "native"){
+        throw error(kind, "Expected 'native' after the 'import' keyword");
+      }
+      Token path = consume(TokenType::STRING, "Expected the path of a native module after 'import native'");
+      consume(TokenType::SEMICOLON, "Expected a ';' after an 'import' statement");
+
+      return std::make_shared<Import>(keyword, path);
+    }
+
     /**
      * @brief Represents the "printStmt" rule inside the CFG of the Bleach language.
      *
@@ -587,7 +607,7 @@ class Parser{
 
       consume(TokenType::SEMICOLON, "Expected a ';' after a variable declaration statement");
 
-      if(nativeFunctions.find(name.lexeme) != nativeFunctions.end()){
+      if(name.lexeme.find(':') != std::string::npos){ // The names of the native functions (including the ones of native modules) are the only identifiers with ':' characters.
         error(name, "Cannot use a Bleach native function as a variable name");
       }
 
@@ -648,7 +668,7 @@ class Parser{
 
         if(Variable* e = dynamic_cast<Variable*>(expr.get())){ // This cast is what certify us that the left-hand side operand of the assignment expression is, indeed, a 'Variable' expression.
           Token name = e->name;
-          if(nativeFunctions.find(name.lexeme) != nativeFunctions.end()){
+          if(name.lexeme.find(':') != std::string::npos){
             error(name, "Cannot use a Bleach native function as an assignment target");
           }
           return std::make_shared<Assign>(std::move(name), value); // This also makes the right-to-left associativity of the assignment expression/operator evident. Recursion -> right associativity and Loop -> left associativity.
@@ -0,0 +1,525 @@
+#pragma once
+
+#include <any>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../utils/Expr.hpp"
+#include "../utils/Stmt.hpp"
+
+
+/**
+ * @class Optimizer
+ *
+ * @brief Eliminates the common subexpressions of a list of statements (e.g. the body of a function or of a
+ * loop) once it has been resolved.
+ *
+ * The Optimizer class walks the statements of the list in the order they are executed, and gives every
+ * subexpression that may be reused a key that describes its structure (e.g. "self.heap.getAt($i)"). A
+ * subexpression may be reused if it only reads variables, "self", literals, properties and the results of
+ * operators and calls. Every subexpression that shows up more than once with the same key, without any of the
+ * variables it reads being assigned (or declared again) between such occurrences, is wrapped into Cached nodes
+ * that share the same value (see the Cached struct). Since the functions it calls might read any variable, a
+ * subexpression that contains a call stops being shared by any assignment.
+ * Only the statements that run in a straight line are considered: An "if" statement contributes its condition,
+ * and every other compound statement (blocks, loops, declarations, "break" and "continue") ends the run of
+ * statements, since it might assign anything. The right operand of a logical operator and the branches of a
+ * ternary operator are not always evaluated, so no occurrence is taken from them. Their own lists of statements
+ * (and the bodies of lambda functions) are optimized when the Resolver class resolves them.
+ *
+ * @note Calls and assignments to fields are not analyzed here: Whether they have side effects is only known at
+ * runtime, where they invalidate the values of the Cached nodes (see the "sideEffects" attribute of the
+ * Interpreter class).
+**/
+class Optimizer{
+  private:
+    struct Group{
+      std::vector<std::shared_ptr<Expr>*> occurrences; // The places of the AST where the subexpression shows up, in order of evaluation.
+      std::vector<std::string> variables; // The variables read by the subexpression ("()" stands for the ones read by the functions it calls).
+    };
+
+    std::vector<Group> groups;
+    std::unordered_map<std::string, std::size_t> active; // Maps the key of a subexpression to its group, while its occurrences can still be shared.
+
+    static std::string literalKey(const std::any& value){
+      if(value.type() == typeid(double)){
+        std::ostringstream stream;
+        stream << std::setprecision(17) << std::any_cast<double>(value);
+        return "#" + stream.str();
+      }else if(value.type() == typeid(std::string)){
+        const std::string& str = std::any_cast<const std::string&>(value);
+        return "\"" + std::to_string(str.size()) + ":" + str; // The length keeps strings with quotes from clashing with other keys.
+      }else if(value.type() == typeid(bool)){
+        return std::any_cast<bool>(value) ? "true" : "false";
+      }
+
+      return "nil";
+    }
+
+    void record(std::shared_ptr<Expr>& slot, const std::string& key, std::vector<std::string> variables){
+      auto elem = active.find(key);
+      if(elem != active.end()){
+        groups[elem->second].occurrences.push_back(&slot);
+        return;
+      }
+
+      active[key] = groups.size();
+      groups.push_back(Group{{&slot}, std::move(variables)});
+
+      return;
+    }
+
+    void kill(const std::string& name){
+      for(auto elem = active.begin(); elem != active.end();){
+        const std::vector<std::string>& variables = groups[elem->second].variables;
+        bool reads = false;
+        for(const std::string& variable : variables){
+          if(variable == name || variable == "()"){ // A function might read any variable it can see.
+            reads = true;
+            break;
+          }
+        }
+        elem = reads ? active.erase(elem) : std::next(elem);
+      }
+
+      return;
+    }
+
+    /**
+     * @brief Visits a subexpression in order of evaluation, recording its occurrence and appending its key.
+     *
+     * @param slot: The place of the AST that holds the subexpression.
+     * @param conditional: Whether the subexpression might not be evaluated (then, it's not recorded).
+     * @param key: The key of the enclosing subexpression, to which the key of this one is appended.
+     * @param variables: The variables read by the enclosing subexpression, to which the ones read by this one are
+     * appended.
+     *
+     * @return Whether the subexpression may be reused.
+    **/
+    bool visit(std::shared_ptr<Expr>& slot, bool conditional, std::string& key, std::vector<std::string>& variables){
+      std::size_t keyStart = key.size();
+      std::size_t variablesStart = variables.size();
+      bool reusable = false;
+
+      switch(slot->kind){
+        case(ExprKind::VARIABLE):
+          key += "$" + std::static_pointer_cast<Variable>(slot)->name.lexeme;
+          variables.push_back(std::static_pointer_cast<Variable>(slot)->name.lexeme);
+          return true;
+        case(ExprKind::SELF):
+          key += "self";
+          return true;
+        case(ExprKind::LITERAL):
+          key += literalKey(std::static_pointer_cast<Literal>(slot)->value);
+          return true;
+        case(ExprKind::GROUPING):
+          return visit(std::static_pointer_cast<Grouping>(slot)->expression, conditional, key, variables);
+        case(ExprKind::UNARY):{
+          auto unary = std::static_pointer_cast<Unary>(slot);
+          key += "(" + unary->op.lexeme;
+          reusable = visit(unary->right, conditional, key, variables);
+          key += ")";
+          break;
+        }
+        case(ExprKind::BINARY):{
+          auto binary = std::static_pointer_cast<Binary>(slot);
+          key += "(";
+          reusable = visit(binary->left, conditional, key, variables);
+          key += " " + binary->op.lexeme + " ";
+          reusable = visit(binary->right, conditional, key, variables) && reusable;
+          key += ")";
+          break;
+        }
+        case(ExprKind::GET):{
+          auto get = std::static_pointer_cast<Get>(slot);
+          reusable = visit(get->object, conditional, key, variables);
+          key += "." + get->name.lexeme;
+          break;
+        }
+        case(ExprKind::CALL):{
+          auto call = std::static_pointer_cast<Call>(slot);
+          variables.push_back("()");
+          if(call->callee->kind == ExprKind::GET){ // The callee of "object.method(...)" is never replaced, since the Interpreter class calls such methods directly.
+            auto get = std::static_pointer_cast<Get>(call->callee);
+            reusable = visit(get->object, conditional, key, variables);
+            key += "." + get->name.lexeme;
+          }else if(call->callee->kind == ExprKind::VARIABLE){
+            reusable = visit(call->callee, conditional, key, variables);
+          }else{
+            visit(call->callee, conditional, key, variables);
+          }
+          key += "(";
+          for(std::shared_ptr<Expr>& argument : call->arguments){
+            reusable = visit(argument, conditional, key, variables) && reusable;
+            key += ",";
+          }
+          key += ")";
+          break;
+        }
+        case(ExprKind::LOGICAL):{
+          auto logical = std::static_pointer_cast<Logical>(slot);
+          visit(logical->left, conditional, key, variables);
+          visit(logical->right, true, key, variables);
+          return false;
+        }
+        case(ExprKind::TERNARY):{
+          auto ternary = std::static_pointer_cast<Ternary>(slot);
+          visit(ternary->condition, conditional, key, variables);
+          visit(ternary->ifBranch, true, key, variables);
+          visit(ternary->elseBranch, true, key, variables);
+          return false;
+        }
+        case(ExprKind::LISTLITERAL):
+          for(std::shared_ptr<Expr>& element : std::static_pointer_cast<ListLiteral>(slot)->elements){
+            visit(element, conditional, key, variables);
+          }
+          return false;
+        case(ExprKind::ASSIGN):{
+          auto assign = std::static_pointer_cast<Assign>(slot);
+          visit(assign->value, conditional, key, variables);
+          kill(assign->name.lexeme);
+          return false;
+        }
+        case(ExprKind::SET):{
+          auto set = std::static_pointer_cast<Set>(slot);
+          visit(set->object, conditional, key, variables);
+          visit(set->value, conditional, key, variables);
+          return false;
+        }
+        case(ExprKind::CACHED): // Already optimized (the list is being resolved again): Only the assignments inside it matter.
+          visit(std::static_pointer_cast<Cached>(slot)->expression, true, key, variables);
+          return false;
+        case(ExprKind::LAMBDAFUNCTION):
+        case(ExprKind::SUPER):
+          return false;
+      }
+
+      if(reusable && !conditional){
+        record(slot, key.substr(keyStart), std::vector<std::string>(variables.begin() + variablesStart, variables.end()));
+      }
+
+      return reusable;
+    }
+
+    void visit(std::shared_ptr<Expr>& expression){
+      std::string key;
+      std::vector<std::string> variables;
+      visit(expression, false, key, variables);
+
+      return;
+    }
+
+    void visit(const std::shared_ptr<Stmt>& statement){
+      switch(statement->kind){
+        case(StmtKind::EXPRESSION):
+          visit(std::static_pointer_cast<Expression>(statement)->expression);
+          return;
+        case(StmtKind::PRINT):
+          visit(std::static_pointer_cast<Print>(statement)->expression);
+          return;
+        case(StmtKind::RETURN):{
+          auto returnStmt = std::static_pointer_cast<Return>(statement);
+          if(returnStmt->value != nullptr){
+            visit(returnStmt->value);
+          }
+          return;
+        }
+        case(StmtKind::VAR):{
+          auto var = std::static_pointer_cast<Var>(statement);
+          if(var->initializer != nullptr){
+            visit(var->initializer);
+          }
+          kill(var->name.lexeme); // From now on, the name refers to the new variable.
+          return;
+        }
+        case(StmtKind::IF):
+          visit(std::static_pointer_cast<If>(statement)->ifCondition);
+          active.clear();
+          return;
+        default:
+          active.clear();
+          return;
+      }
+    }
+
+    void replaceCommonSubexpressions(){
+      for(Group& group : groups){
+        if(group.occurrences.size() < 2){
+          continue;
+        }
+
+        auto cell = std::make_shared<CachedValue>();
+        for(std::size_t i = 0; i < group.occurrences.size(); i++){
+          std::shared_ptr<Expr>& slot = *group.occurrences[i];
+          slot = std::make_shared<Cached>(std::move(slot), cell, i == 0); // Nested occurrences stay valid, since the node that holds them is moved into the Cached node.
+        }
+      }
+
+      return;
+    }
+
+    using ExprCallback = std::function<void(const std::shared_ptr<Expr>&)>;
+    using StmtCallback = std::function<void(const std::shared_ptr<Stmt>&)>;
+
+    // Calls "onExpr" for every expression and "onStmt" for every statement inside the received one, including the bodies of the functions and lambda functions declared inside it.
+    static void walk(const std::shared_ptr<Expr>& expression, const ExprCallback& onExpr, const StmtCallback& onStmt){
+      if(expression == nullptr){
+        return;
+      }
+      onExpr(expression);
+
+      switch(expression->kind){
+        case(ExprKind::ASSIGN):
+          walk(std::static_pointer_cast<Assign>(expression)->value, onExpr, onStmt);
+          break;
+        case(ExprKind::BINARY):
+          walk(std::static_pointer_cast<Binary>(expression)->left, onExpr, onStmt);
+          walk(std::static_pointer_cast<Binary>(expression)->right, onExpr, onStmt);
+          break;
+        case(ExprKind::CACHED):
+          walk(std::static_pointer_cast<Cached>(expression)->expression, onExpr, onStmt);
+          break;
+        case(ExprKind::CALL):
+          walk(std::static_pointer_cast<Call>(expression)->callee, onExpr, onStmt);
+          for(const std::shared_ptr<Expr>& argument : std::static_pointer_cast<Call>(expression)->arguments){
+            walk(argument, onExpr, onStmt);
+          }
+          break;
+        case(ExprKind::GET):
+          walk(std::static_pointer_cast<Get>(expression)->object, onExpr, onStmt);
+          break;
+        case(ExprKind::GROUPING):
+          walk(std::static_pointer_cast<Grouping>(expression)->expression, onExpr, onStmt);
+          break;
+        case(ExprKind::LAMBDAFUNCTION):
+          for(const std::shared_ptr<Stmt>& statement : std::static_pointer_cast<LambdaFunction>(expression)->body){
+            walk(statement, onExpr, onStmt);
+          }
+          break;
+        case(ExprKind::LISTLITERAL):
+          for(const std::shared_ptr<Expr>& element : std::static_pointer_cast<ListLiteral>(expression)->elements){
+            walk(element, onExpr, onStmt);
+          }
+          break;
+        case(ExprKind::LOGICAL):
+          walk(std::static_pointer_cast<Logical>(expression)->left, onExpr, onStmt);
+          walk(std::static_pointer_cast<Logical>(expression)->right, onExpr, onStmt);
+          break;
+        case(ExprKind::SET):
+          walk(std::static_pointer_cast<Set>(expression)->object, onExpr, onStmt);
+          walk(std::static_pointer_cast<Set>(expression)->value, onExpr, onStmt);
+          break;
+        case(ExprKind::TERNARY):
+          walk(std::static_pointer_cast<Ternary>(expression)->condition, onExpr, onStmt);
+          walk(std::static_pointer_cast<Ternary>(expression)->ifBranch, onExpr, onStmt);
+          walk(std::static_pointer_cast<Ternary>(expression)->elseBranch, onExpr, onStmt);
+          break;
+        case(ExprKind::UNARY):
+          walk(std::static_pointer_cast<Unary>(expression)->right, onExpr, onStmt);
+          break;
+        case(ExprKind::LITERAL):
+        case(ExprKind::SELF):
+        case(ExprKind::SUPER):
+        case(ExprKind::VARIABLE):
+          break;
+      }
+
+      return;
+    }
+
+    static void walk(const std::shared_ptr<Stmt>& statement, const ExprCallback& onExpr, const StmtCallback& onStmt){
+      if(statement == nullptr){
+        return;
+      }
+      onStmt(statement);
+
+      auto walkAll = [&](const std::vector<std::shared_ptr<Stmt>>& statements){
+        for(const std::shared_ptr<Stmt>& inner : statements){
+          walk(inner, onExpr, onStmt);
+        }
+      };
+
+      switch(statement->kind){
+        case(StmtKind::BLOCK):
+          walkAll(std::static_pointer_cast<Block>(statement)->statements);
+          break;
+        case(StmtKind::CLASS):
+          for(const std::shared_ptr<Function>& method : std::static_pointer_cast<Class>(statement)->methods){
+            walk(method, onExpr, onStmt);
+          }
+          break;
+        case(StmtKind::DOWHILE):
+          walkAll(std::static_pointer_cast<DoWhile>(statement)->body);
+          walk(std::static_pointer_cast<DoWhile>(statement)->condition, onExpr, onStmt);
+          break;
+        case(StmtKind::EXPRESSION):
+          walk(std::static_pointer_cast<Expression>(statement)->expression, onExpr, onStmt);
+          break;
+        case(StmtKind::FOR):{
+          auto loop = std::static_pointer_cast<For>(statement);
+          walk(loop->initializer, onExpr, onStmt);
+          walk(loop->condition, onExpr, onStmt);
+          walkAll(loop->body);
+          walk(loop->increment, onExpr, onStmt);
+          break;
+        }
+        case(StmtKind::FUNCTION):
+          walkAll(std::static_pointer_cast<Function>(statement)->body);
+          break;
+        case(StmtKind::IF):{
+          auto ifStmt = std::static_pointer_cast<If>(statement);
+          walk(ifStmt->ifCondition, onExpr, onStmt);
+          walk(ifStmt->ifBranch, onExpr, onStmt);
+          for(std::size_t i = 0; i < ifStmt->elifConditions.size(); i++){
+            walk(ifStmt->elifConditions[i], onExpr, onStmt);
+            walk(ifStmt->elifBranches[i], onExpr, onStmt);
+          }
+          walk(ifStmt->elseBranch, onExpr, onStmt);
+          break;
+        }
+        case(StmtKind::PRINT):
+          walk(std::static_pointer_cast<Print>(statement)->expression, onExpr, onStmt);
+          break;
+        case(StmtKind::RETURN):
+          walk(std::static_pointer_cast<Return>(statement)->value, onExpr, onStmt);
+          break;
+        case(StmtKind::VAR):
+          walk(std::static_pointer_cast<Var>(statement)->initializer, onExpr, onStmt);
+          break;
+        case(StmtKind::WHILE):
+          walk(std::static_pointer_cast<While>(statement)->condition, onExpr, onStmt);
+          walkAll(std::static_pointer_cast<While>(statement)->body);
+          break;
+        case(StmtKind::BREAK):
+        case(StmtKind::CONTINUE):
+        case(StmtKind::IMPORT):
+          break;
+      }
+
+      return;
+    }
+
+    static bool isNonNegativeInteger(const std::shared_ptr<Expr>& expression, bool positive){
+      if(expression == nullptr || expression->kind != ExprKind::LITERAL){
+        return false;
+      }
+
+      const std::any& value = std::static_pointer_cast<Literal>(expression)->value;
+      if(value.type() != typeid(double)){
+        return false;
+      }
+      double number = std::any_cast<double>(value);
+
+      return std::floor(number) == number && (positive ? number > 0 : number >= 0);
+    }
+
+  public:
+    /**
+     * @brief Removes the checks of the index of the "getAt" calls that are indexed by the induction variable of a
+     * "for" loop, once the loop has been resolved.
+     *
+     * The induction variable ("i") of a loop such as "for(let i = 0; i < list.size(); i = i + 1){ ... }" is known to
+     * hold a non-negative integer if it starts at a non-negative integer literal, it's only increased by a positive
+     * integer literal in the increment of the loop, and neither the condition nor the body (including the functions
+     * and lambda functions declared inside it) assign or declare a variable with the same name. Then, every
+     * "object.getAt(i)" call inside the loop is marked (see the "indexedAccess" attribute of the Call struct), so
+     * the Interpreter class reads the element straight from the list, without checking the type and the value of
+     * the index or creating the "getAt" method. Only a comparison against the size of the list is kept, since the
+     * list might still be resized through another reference to it.
+     *
+     * @param loop: The "for" loop.
+     *
+     * @return Nothing (void).
+    **/
+    static void eliminateIndexChecks(const std::shared_ptr<For>& loop){
+      if(loop->initializer == nullptr || loop->initializer->kind != StmtKind::VAR || loop->increment == nullptr || loop->increment->kind != ExprKind::ASSIGN){
+        return;
+      }
+
+      auto initializer = std::static_pointer_cast<Var>(loop->initializer);
+      const std::string& name = initializer->name.lexeme;
+      if(!isNonNegativeInteger(initializer->initializer, false)){
+        return;
+      }
+
+      auto increment = std::static_pointer_cast<Assign>(loop->increment); // Only "i = i + step" is accepted.
+      if(increment->name.lexeme != name || increment->value->kind != ExprKind::BINARY){
+        return;
+      }
+      auto step = std::static_pointer_cast<Binary>(increment->value);
+      if(step->op.type != TokenType::PLUS || step->left->kind != ExprKind::VARIABLE || std::static_pointer_cast<Variable>(step->left)->name.lexeme != name || !isNonNegativeInteger(step->right, true)){
+        return;
+      }
+
+      bool changed = false; // Whether the condition or the body assign or declare a variable with the same name.
+      std::vector<std::shared_ptr<Call>> accesses;
+      ExprCallback onExpr = [&](const std::shared_ptr<Expr>& expression){
+        if(expression->kind == ExprKind::ASSIGN){
+          changed = changed || std::static_pointer_cast<Assign>(expression)->name.lexeme == name;
+        }else if(expression->kind == ExprKind::LAMBDAFUNCTION){
+          for(const Token& parameter : std::static_pointer_cast<LambdaFunction>(expression)->parameters){
+            changed = changed || parameter.lexeme == name;
+          }
+        }else if(expression->kind == ExprKind::CALL){
+          auto call = std::static_pointer_cast<Call>(expression);
+          if(call->callee->kind == ExprKind::GET && std::static_pointer_cast<Get>(call->callee)->name.lexeme == "getAt" && call->arguments.size() == 1 && call->arguments[0]->kind == ExprKind::VARIABLE && std::static_pointer_cast<Variable>(call->arguments[0])->name.lexeme == name){
+            accesses.push_back(call);
+          }
+        }
+      };
+      StmtCallback onStmt = [&](const std::shared_ptr<Stmt>& statement){
+        if(statement->kind == StmtKind::VAR){
+          changed = changed || std::static_pointer_cast<Var>(statement)->name.lexeme == name;
+        }else if(statement->kind == StmtKind::FUNCTION){
+          auto function = std::static_pointer_cast<Function>(statement);
+          changed = changed || function->name.lexeme == name;
+          for(const Token& parameter : function->parameters){
+            changed = changed || parameter.lexeme == name;
+          }
+        }else if(statement->kind == StmtKind::CLASS){
+          changed = changed || std::static_pointer_cast<Class>(statement)->name.lexeme == name;
+        }
+      };
+
+      walk(loop->condition, onExpr, onStmt);
+      for(const std::shared_ptr<Stmt>& statement : loop->body){
+        walk(statement, onExpr, onStmt);
+      }
+
+      if(changed){
+        return;
+      }
+      for(const std::shared_ptr<Call>& access : accesses){
+        access->indexedAccess = true;
+      }
+
+      return;
+    }
+
+    /**
+     * @brief Replaces the common subexpressions of a list of statements with Cached nodes.
+     *
+     * @param statements: The list of statements. It must have been resolved already.
+     *
+     * @return Nothing (void).
+    **/
+    static void eliminateCommonSubexpressions(const std::vector<std::shared_ptr<Stmt>>& statements){
+      Optimizer optimizer;
+
+      for(const std::shared_ptr<Stmt>& statement : statements){
+        if(statement != nullptr){
+          optimizer.visit(statement);
+        }
+      }
+      optimizer.replaceCommonSubexpressions();
+
+      return;
+    }
+};
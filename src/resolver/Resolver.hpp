@@ -1,11 +1,13 @@
 #pragma once
 
+#include <algorithm>
 #include <functional>
 #include <map>
 #include <memory>
 #include <vector>
 
 #include "../interpreter/Interpreter.hpp"
+#include "./Optimizer.hpp"
 
 class Resolver : public ExprVisitor, public StmtVisitor{
   private:
@@ -31,6 +33,10 @@ class Resolver : public ExprVisitor, public StmtVisitor{
     ClassType currentClass = ClassType::NONE;
     FunctionType currentFunction = FunctionType::NONE;
     InsideLoop currentLoop = InsideLoop::NO_LOOP;
+    int currentReturnCount = 0; // Amount of return statements found so far inside the function that is being resolved.
+    bool currentFunctionPure = true; // Whether no side effect has been found so far inside the function that is being resolved.
+    std::size_t currentFunctionScope = 0; // Index of the scope of the parameters of the function that is being resolved.
+    std::shared_ptr<Class> currentClassDeclaration = nullptr; // The class declaration whose methods are being resolved. It collects the super expressions of such methods.
 
     void declare(const Token& name){
       if(scopes.empty()){
@@ -80,9 +86,34 @@ class Resolver : public ExprVisitor, public StmtVisitor{
       return;
     }
 
+    // Checks whether any of the statements declares a variable, a function or a class directly in the scope that encloses them.
+    static bool declaresNames(const std::vector<std::shared_ptr<Stmt>>& statements){
+      for(const std::shared_ptr<Stmt>& statement : statements){
+        if(statement != nullptr && (statement->kind == StmtKind::VAR || statement->kind == StmtKind::FUNCTION || statement->kind == StmtKind::CLASS)){
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    // Marks the function that is being resolved as impure. A function is pure if its body does not assign to fields or to variables declared outside of it, does not print, does not import native modules and does not call the methods that mutate lists. Calls inside its body do not matter: An impure callee reports its own side effects when it's called.
+    void sideEffect(){
+      currentFunctionPure = false;
+
+      return;
+    }
+
     void resolveFunction(std::shared_ptr<Function> function, FunctionType functionType){
       FunctionType enclosingFunction = currentFunction;
+      int enclosingReturnCount = currentReturnCount;
+      bool enclosingFunctionPure = currentFunctionPure;
+      std::size_t enclosingFunctionScope = currentFunctionScope;
       currentFunction = functionType;
+      currentReturnCount = 0;
+      currentFunctionPure = true;
+      currentFunctionScope = scopes.size();
+      function->declarationId = interpreter.registerDeclaration(function);
 
       beginScope();
       
@@ -94,21 +125,25 @@ class Resolver : public ExprVisitor, public StmtVisitor{
 
       endScope();
 
+      function->tailReturn = (currentReturnCount == 1 && function->body.back()->kind == StmtKind::RETURN); // The only return statement is the last statement of the function, so it can be evaluated without unwinding.
+      function->pure = currentFunctionPure;
+
       currentFunction = enclosingFunction;
+      currentReturnCount = enclosingReturnCount;
+      currentFunctionPure = enclosingFunctionPure;
+      currentFunctionScope = enclosingFunctionScope;
 
       return;
     }
 
-    void resolveLocal(std::shared_ptr<Expr> expr, const Token& name){
+    int resolveLocal(const Token& name){
       for(int i = scopes.size() - 1; i >= 0; i--){
         if(scopes[i].find(name.lexeme) != scopes[i].end()){
-          interpreter.resolve(expr, scopes.size() - 1 - i); // This tells the interpreter how many hops it will need to do in order to find the variable declaration to which this Variable expression is referring to. 
-          // We pass the Variable expression pointer because if the token was passed, it would not work properly. A pointer is unique. A Token is not.
-          return;
+          return scopes.size() - 1 - i; // This tells the interpreter how many hops it will need to do in order to find the variable declaration to which the expression is referring to. It's stored inside the expression node itself.
         }
       }
 
-      return;
+      return -1; // Not found in any local scope: The variable is assumed to be a global one.
     }
 
   public:
@@ -120,13 +155,28 @@ class Resolver : public ExprVisitor, public StmtVisitor{
       for(const std::shared_ptr<Stmt>& statement : statements){
         resolve(statement);
       }
+      Optimizer::eliminateCommonSubexpressions(statements); // Every list of statements (a program, a block, the body of a function or of a loop) is optimized once it has been resolved.
 
       return;
     }
 
     std::any visitAssignExpr(std::shared_ptr<Assign> expr) override{
       resolve(expr->value); // First, the resolver needs to resolve the r-value of the assignment expression.
-      resolveLocal(expr, expr->name); // Then, the resolver resolves the l-value of the assignment expression. This is used to figure out to which variable the l-value is referring to.
+      expr->depth = resolveLocal(expr->name); // Then, the resolver resolves the l-value of the assignment expression. This is used to figure out to which variable the l-value is referring to.
+      if(expr->depth == -1){
+        expr->globalSlot = interpreter.resolveGlobal(expr->name.lexeme);
+      }
+      if(expr->depth == -1 || scopes.size() - 1 - expr->depth < currentFunctionScope){ // The variable is declared outside of the function that is being resolved.
+        sideEffect();
+      }
+
+      if(expr->value->kind == ExprKind::BINARY){
+        auto binary = std::static_pointer_cast<Binary>(expr->value);
+        if(binary->op.type == TokenType::PLUS && binary->left->kind == ExprKind::VARIABLE){
+          auto variable = std::static_pointer_cast<Variable>(binary->left);
+          expr->accumulates = (variable->name.lexeme == expr->name.lexeme && variable->depth == expr->depth && variable->globalSlot == expr->globalSlot);
+        }
+      }
 
       return {};
     }
@@ -138,9 +188,22 @@ class Resolver : public ExprVisitor, public StmtVisitor{
       return {};
     }
 
+    std::any visitCachedExpr(std::shared_ptr<Cached> expr) override{
+      resolve(expr->expression);
+
+      return {};
+    }
+
     std::any visitCallExpr(std::shared_ptr<Call> expr) override{
       resolve(expr->callee);
 
+      if(expr->callee->kind == ExprKind::GET){
+        const std::string& method = std::static_pointer_cast<Get>(expr->callee)->name.lexeme;
+        if(method == "append" || method == "clear" || method == "extend" || method == "fill" || method == "pop" || method == "setAt"){ // The methods that mutate lists.
+          sideEffect();
+        }
+      }
+
       for(int i = 0; i < expr->arguments.size(); i++){
         resolve(expr->arguments[i]);
       }
@@ -162,7 +225,13 @@ class Resolver : public ExprVisitor, public StmtVisitor{
 
     std::any visitLambdaFunctionExpr(std::shared_ptr<LambdaFunction> expr) override{
       FunctionType enclosingFunction = currentFunction;
+      int enclosingReturnCount = currentReturnCount;
+      bool enclosingFunctionPure = currentFunctionPure;
+      std::size_t enclosingFunctionScope = currentFunctionScope;
       currentFunction = FunctionType::LAMBDAFUNCTION;
+      currentFunctionPure = true;
+      currentFunctionScope = scopes.size();
+      expr->declarationId = interpreter.registerDeclaration(expr);
 
       beginScope();
 
@@ -174,7 +243,12 @@ class Resolver : public ExprVisitor, public StmtVisitor{
 
       endScope();
 
+      expr->pure = currentFunctionPure;
+
       currentFunction = enclosingFunction;
+      currentReturnCount = enclosingReturnCount; // The return statements of a lambda function do not belong to the enclosing function.
+      currentFunctionPure = enclosingFunctionPure;
+      currentFunctionScope = enclosingFunctionScope;
 
       return {};
     }
@@ -202,7 +276,7 @@ class Resolver : public ExprVisitor, public StmtVisitor{
       if(currentClass == ClassType::NONE){
         error(expr->keyword, "Cannot use 'self' outside of a class");
       }
-      resolveLocal(expr, expr->keyword); // Since "self" is considered to be a kind of hidden variable, we need to treat it like so.
+      expr->depth = resolveLocal(expr->keyword); // Since "self" is considered to be a kind of hidden variable, we need to treat it like so.
 
       return {};
     }
@@ -210,6 +284,14 @@ class Resolver : public ExprVisitor, public StmtVisitor{
     std::any visitSetExpr(std::shared_ptr<Set> expr) override{
       resolve(expr->value);
       resolve(expr->object);
+      sideEffect();
+
+      if(currentFunction == FunctionType::INITIALIZER && expr->object->kind == ExprKind::SELF){ // A "self.field = value" assignment inside an "init" method is part of the layout of the instances of the class.
+        std::vector<int>& fieldIds = currentClassDeclaration->fieldIds;
+        if(std::find(fieldIds.begin(), fieldIds.end(), expr->nameId) == fieldIds.end()){
+          fieldIds.push_back(expr->nameId);
+        }
+      }
 
       return {};
     }
@@ -221,7 +303,11 @@ class Resolver : public ExprVisitor, public StmtVisitor{
         error(expr->keyword, "Cannot use the 'super' keyword inside a class that does not have a superclass");
       }
 
-      resolveLocal(expr, expr->keyword);
+      expr->depth = resolveLocal(expr->keyword);
+
+      if(currentClassDeclaration != nullptr){
+        currentClassDeclaration->superExprs.push_back(expr); // The method this expression refers to will be resolved when the class is finalized.
+      }
 
       return {};
     }
@@ -249,15 +335,24 @@ class Resolver : public ExprVisitor, public StmtVisitor{
         }
       }
 
-      resolveLocal(expr, expr->name);
+      expr->depth = resolveLocal(expr->name);
+      if(expr->depth == -1){
+        expr->globalSlot = interpreter.resolveGlobal(expr->name.lexeme); // Global variables are accessed through their slot. The variable might still be defined later on, so it's only checked at runtime.
+      }
 
       return {};
     }
 
     std::any visitBlockStmt(std::shared_ptr<Block> stmt) override{
-      beginScope();
+      stmt->needsScope = declaresNames(stmt->statements); // A block that declares nothing does not get a scope (nor an environment at runtime), so the distances to the variables it uses are one hop shorter.
+
+      if(stmt->needsScope){
+        beginScope();
+      }
       resolve(stmt->statements);
-      endScope();
+      if(stmt->needsScope){
+        endScope();
+      }
 
       return {};
     }
@@ -272,7 +367,11 @@ class Resolver : public ExprVisitor, public StmtVisitor{
 
     std::any visitClassStmt(std::shared_ptr<Class> stmt) override{
       ClassType enclosingClass = currentClass;
+      std::shared_ptr<Class> enclosingClassDeclaration = currentClassDeclaration;
       currentClass = ClassType::CLASS;
+      currentClassDeclaration = stmt;
+      stmt->superExprs.clear(); // The lists are refilled every time the declaration is resolved.
+      stmt->fieldIds.clear();
 
       declare(stmt->name);
       define(stmt->name);
@@ -309,6 +408,7 @@ class Resolver : public ExprVisitor, public StmtVisitor{
       }
 
       currentClass = enclosingClass;
+      currentClassDeclaration = enclosingClassDeclaration;
 
       return {};
     }
@@ -325,11 +425,16 @@ class Resolver : public ExprVisitor, public StmtVisitor{
       InsideLoop enclosingLoop = currentLoop;
 
       currentLoop = InsideLoop::INSIDE_LOOP;
+      stmt->needsScope = declaresNames(stmt->body);
 
-      beginScope();
+      if(stmt->needsScope){
+        beginScope();
+      }
       resolve(stmt->body);
       resolve(stmt->condition);
-      endScope();
+      if(stmt->needsScope){
+        endScope();
+      }
 
       currentLoop = enclosingLoop;
 
@@ -346,13 +451,19 @@ class Resolver : public ExprVisitor, public StmtVisitor{
       InsideLoop enclosingLoop = currentLoop;
 
       currentLoop = InsideLoop::INSIDE_LOOP;
+      stmt->needsScope = declaresNames(stmt->body) || declaresNames({stmt->initializer});
 
-      beginScope();
+      if(stmt->needsScope){
+        beginScope();
+      }
       resolve(stmt->initializer);
       resolve(stmt->condition);
       resolve(stmt->body);
       resolve(stmt->increment);
-      endScope();
+      if(stmt->needsScope){
+        endScope();
+      }
+      Optimizer::eliminateIndexChecks(stmt);
 
       currentLoop = enclosingLoop;
 
@@ -386,8 +497,15 @@ class Resolver : public ExprVisitor, public StmtVisitor{
       return {};
     }
 
+    std::any visitImportStmt(std::shared_ptr<Import> stmt) override{ // The names defined by a native module are global variables, which are only checked at runtime.
+      sideEffect();
+
+      return {};
+    }
+
     std::any visitPrintStmt(std::shared_ptr<Print> stmt) override{
       resolve(stmt->expression);
+      sideEffect();
 
       return {};
     }
@@ -396,6 +514,7 @@ class Resolver : public ExprVisitor, public StmtVisitor{
       if(currentFunction == FunctionType::NONE){
         error(stmt->keyword, "Cannot use the 'return' keyword outside of a function, lambda or method");
       }
+      currentReturnCount++;
 
       if(stmt->value != nullptr){
         if(currentFunction == FunctionType::INITIALIZER){
@@ -421,11 +540,16 @@ class Resolver : public ExprVisitor, public StmtVisitor{
       InsideLoop enclosingLoop = currentLoop;
 
       currentLoop = InsideLoop::INSIDE_LOOP;
+      stmt->needsScope = declaresNames(stmt->body);
 
-      beginScope();
+      if(stmt->needsScope){
+        beginScope();
+      }
       resolve(stmt->condition);
       resolve(stmt->body);
-      endScope();
+      if(stmt->needsScope){
+        endScope();
+      }
 
       currentLoop = enclosingLoop;
 
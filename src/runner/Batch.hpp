@@ -0,0 +1,135 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "./Runner.hpp"
+
+
+/**
+ * @brief Reads a manifest file: A text file with the path of one Bleach file per line. Empty lines and lines 
+ * that start with "#" are ignored. Relative paths are taken relative to the directory of the manifest.
+ * 
+ * @param manifestPath The path to the manifest file.
+ * @param filePaths The list that receives the paths listed inside the manifest.
+ * 
+ * @return A boolean that tells whether the manifest could be read.
+**/
+inline bool readManifest(const std::string& manifestPath, std::vector<std::string>& filePaths){
+  std::ifstream manifest{manifestPath};
+  if(!manifest){
+    std::cerr << RED << "[BLEACH Interpreter Error]: Failed to open manifest '" << manifestPath << "'." << WHITE << std::endl;
+    return false;
+  }
+
+  std::filesystem::path baseDirectory = std::filesystem::path{manifestPath}.parent_path();
+  std::string line;
+  while(std::getline(manifest, line)){
+    line.erase(line.find_last_not_of(" \t\r") + 1);
+    line.erase(0, line.find_first_not_of(" \t"));
+    if(line.empty() || line[0] == '#'){
+      continue;
+    }
+
+    std::filesystem::path path{line};
+    filePaths.push_back(path.is_absolute() ? line : (baseDirectory / path).string());
+  }
+
+  return true;
+}
+
+/**
+ * @brief Starts up the BLEACH Interpreter in the "Batch Mode".
+ * 
+ * This function is responsible for running many Bleach files inside a single process. Each file is run in 
+ * isolation (see the "runIsolated" function), optionally in parallel by a pool of threads. The usage is:
+ * 
+ *   ./BleachInterpreter --batch [--jobs N] [--out DIR] file1.bch file2.bch @manifest.txt ...
+ * 
+ * "--jobs N" sets the amount of threads (1 by default). "--out DIR" writes the output and the errors of the 
+ * i-th file to "DIR/<i>_<name>.out" and "DIR/<i>_<name>.err". Without it, the output and the errors of every 
+ * file are written to the standard output and to the standard error, in the order in which the files were 
+ * given. An argument that starts with "@" is a manifest file (see the "readManifest" function). Finally, the
+ * exit status of each file is reported to the standard error.
+ * 
+ * @param arguments The arguments that follow "--batch" in the command line.
+ * 
+ * @return 0 if every file has been run successfully, 1 if some file has failed and 64 if the command line is 
+ * invalid.
+**/
+inline int runBatch(const std::vector<std::string>& arguments){
+  int jobs = 1;
+  std::string outputDirectory;
+  std::vector<std::string> filePaths;
+
+  for(int i = 0; i < arguments.size(); i++){
+    if(arguments[i] == "--jobs" && i + 1 < arguments.size()){
+      jobs = std::max(1, std::atoi(arguments[++i].c_str()));
+    }else if(arguments[i] == "--out" && i + 1 < arguments.size()){
+      outputDirectory = arguments[++i];
+    }else if(arguments[i][0] == '@'){
+      if(!readManifest(arguments[i].substr(1), filePaths)){
+        return 64;
+      }
+    }else{
+      filePaths.push_back(arguments[i]);
+    }
+  }
+
+  if(filePaths.empty()){
+    std::cerr << RED << "[BLEACH Interpreter Error]: No Bleach files were given to the '--batch' mode." << WHITE << std::endl;
+    return 64;
+  }
+  if(!outputDirectory.empty()){
+    std::filesystem::create_directories(outputDirectory);
+  }
+
+  std::vector<ScriptResult> results(filePaths.size());
+  std::atomic<std::size_t> nextFile{0};
+  auto worker = [&](){
+    for(std::size_t i = nextFile++; i < filePaths.size(); i = nextFile++){
+      results[i] = runIsolated(filePaths[i]);
+
+      if(!outputDirectory.empty()){
+        char prefix[16];
+        std::snprintf(prefix, sizeof(prefix), "%04zu_", i + 1);
+        std::filesystem::path base = std::filesystem::path{outputDirectory} / (prefix + std::filesystem::path{filePaths[i]}.stem().string());
+        std::ofstream{base.string() + ".out", std::ios::binary} << results[i].output;
+        std::ofstream{base.string() + ".err", std::ios::binary} << results[i].errors;
+        results[i].output.clear(); // The captured streams are no longer needed.
+        results[i].errors.clear();
+      }
+    }
+  };
+
+  std::vector<std::thread> pool;
+  for(int i = 1; i < std::min<std::size_t>(jobs, filePaths.size()); i++){
+    pool.emplace_back(worker);
+  }
+  worker(); // The main thread is also part of the pool.
+  for(std::thread& thread : pool){
+    thread.join();
+  }
+
+  int failures = 0;
+  for(std::size_t i = 0; i < filePaths.size(); i++){
+    std::cout << results[i].output;
+    std::cerr << results[i].errors;
+    std::cerr << "[BLEACH Batch]: " << filePaths[i] << ": exit status " << results[i].exitStatus << " (" << results[i].milliseconds << " ms)" << std::endl;
+    if(results[i].exitStatus != 0){
+      failures++;
+    }
+  }
+  std::cout << std::flush;
+  std::cerr << "[BLEACH Batch]: " << filePaths.size() << " files run, " << failures << " failed." << std::endl;
+
+  return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,272 @@
+#pragma once
+
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "./Runner.hpp"
+#include "./Socket.hpp"
+
+
+/**
+ * @class ForkServer
+ *
+ * @brief This class is responsible for implementing the "Fork Server Mode" of the BLEACH Interpreter: A
+ * long-lived process that runs a fixed set of Bleach programs on request, each one inside its own child process.
+ *
+ * At startup, the ForkServer class builds one instance of the Interpreter class per Bleach file it receives
+ * (with every native function already registered) and lexes, parses and resolves the file against it. Then, it
+ * listens on a Unix domain socket. Each connection carries a single request, the line "SCRIPT <path>", where
+ * <path> is one of the files given at startup. For each request, the server calls "fork": The child process
+ * receives a copy-on-write copy of the prepared interpreter, applies the resource limits, runs the program and
+ * writes its output and its errors to the connection (in the same format used by the Server class). The server
+ * waits for the child and then writes "EXIT <exit status> <milliseconds>", where the time covers the whole
+ * request (from the "fork" call to the end of the child).
+ * If the child is killed by a signal (for instance, because it has exceeded its CPU time limit), its exit
+ * status is 128 plus the number of the signal.
+ * Every child has a CPU time limit and a wall-clock time limit (10 seconds each, unless the command line says
+ * otherwise), and its standard input is "/dev/null", so a program that loops forever or waits for input (e.g.
+ * through "std::io::readLine") cannot hold up the requests that come after it.
+ *
+ * @note: Since every program runs in a separate process, nothing that a program does (not even a crash) can
+ * affect the server or the next requests.
+**/
+class ForkServer{
+  private:
+    /**
+     * @struct PreparedScript
+     *
+     * @brief Stores a Bleach file that is ready to be run: The instance of the Interpreter class against which
+     * it was resolved and its compiled program.
+    **/
+    struct PreparedScript{
+      std::unique_ptr<Interpreter> interpreter;
+      std::shared_ptr<CompiledProgram> program;
+    };
+
+    const std::string socketPath; /**< Variable that stores the path of the Unix domain socket. */
+    const rlim_t cpuSeconds; /**< Variable that stores the CPU time limit of each child, in seconds. */
+    const unsigned int timeoutSeconds; /**< Variable that stores the wall-clock time limit of each child, in seconds. */
+    const rlim_t memoryMegabytes; /**< Variable that stores the address space limit of each child, in megabytes (0 means no limit). */
+    std::map<std::string, PreparedScript> scripts; /**< Variable that maps the path of each Bleach file to its prepared script. */
+
+    /**
+     * @brief Runs a prepared script. It's only called inside the child process, which never returns from it.
+     *
+     * @param script The prepared script.
+     * @param connection The file descriptor of the connection.
+     *
+     * @return Nothing (the child process exits with the exit status of the program).
+    **/
+    [[noreturn]] void runChild(PreparedScript& script, int connection){
+      int input = open("/dev/null", O_RDONLY); // The program must not read (or wait for) the standard input of the server.
+      if(input >= 0){
+        dup2(input, STDIN_FILENO);
+        close(input);
+      }
+
+      rlimit cpuLimit{cpuSeconds, cpuSeconds};
+      setrlimit(RLIMIT_CPU, &cpuLimit);
+      signal(SIGALRM, SIG_DFL);
+      alarm(timeoutSeconds); // The child is killed by the SIGALRM signal once its wall-clock time limit is reached.
+      if(memoryMegabytes > 0){
+        rlimit limit{memoryMegabytes << 20, memoryMegabytes << 20};
+        setrlimit(RLIMIT_AS, &limit);
+      }
+
+      ScriptResult result = runCaptured([&](){
+        script.interpreter->interpret(script.program->statements);
+
+        return exitStatus();
+      });
+
+      writeAll(connection, "STDOUT " + std::to_string(result.output.size()) + "\n" + result.output);
+      writeAll(connection, "STDERR " + std::to_string(result.errors.size()) + "\n" + result.errors);
+
+      _exit(result.exitStatus); // The buffers and the destructors of the server must not run inside the child.
+    }
+
+    /**
+     * @brief Handles a single request: Reads it, runs the requested script in a child process and writes the
+     * response.
+     *
+     * @param listener The file descriptor of the listening socket (closed inside the child).
+     * @param connection The file descriptor of the connection.
+     *
+     * @return Nothing (void).
+    **/
+    void handle(int listener, int connection){
+      std::string header, body;
+      RequestStatus requestStatus = readRequest(connection, header, body);
+      if(requestStatus == RequestStatus::TOO_LARGE){
+        writeAll(connection, "ERROR request too large\n");
+        return;
+      }
+      if(requestStatus != RequestStatus::COMPLETE || header.rfind("SCRIPT ", 0) != 0){
+        writeAll(connection, "ERROR malformed request\n");
+        return;
+      }
+
+      auto elem = scripts.find(header.substr(7));
+      if(elem == scripts.end()){
+        writeAll(connection, "ERROR unknown script\n");
+        return;
+      }
+
+      auto start = std::chrono::steady_clock::now();
+      pid_t child = fork();
+      if(child < 0){
+        writeAll(connection, "ERROR fork failed\n");
+        return;
+      }
+      if(child == 0){
+        close(listener);
+        runChild(elem->second, connection);
+      }
+
+      int status = 0;
+      while(waitpid(child, &status, 0) < 0 && errno == EINTR){}
+      double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+      int exitStatus = 0;
+      if(WIFSIGNALED(status)){
+        exitStatus = 128 + WTERMSIG(status);
+        std::string message = WTERMSIG(status) == SIGALRM ? "[BLEACH Interpreter Error]: The program has exceeded its time limit of " + std::to_string(timeoutSeconds) + " seconds.\n" : "[BLEACH Interpreter Error]: The program was killed by signal " + std::to_string(WTERMSIG(status)) + ".\n";
+        writeAll(connection, "STDOUT 0\nSTDERR " + std::to_string(message.size()) + "\n" + message);
+      }else{
+        exitStatus = WEXITSTATUS(status);
+      }
+      writeAll(connection, "EXIT " + std::to_string(exitStatus) + " " + std::to_string(milliseconds) + "\n");
+
+      std::cerr << "[BLEACH Fork Server]: " << elem->first << ": exit status " << exitStatus << " (" << milliseconds << " ms)" << std::endl;
+
+      return;
+    }
+
+  public:
+    /**
+     * @brief Constructs a ForkServer that listens on the received path.
+     *
+     * @param socketPath The path of the Unix domain socket. If a file already exists there, it's replaced.
+     * @param cpuSeconds The CPU time limit of each child, in seconds.
+     * @param timeoutSeconds The wall-clock time limit of each child, in seconds.
+     * @param memoryMegabytes The address space limit of each child, in megabytes (0 means no limit).
+    **/
+    ForkServer(std::string socketPath, rlim_t cpuSeconds, unsigned int timeoutSeconds, rlim_t memoryMegabytes)
+      : socketPath{std::move(socketPath)}, cpuSeconds{cpuSeconds}, timeoutSeconds{timeoutSeconds}, memoryMegabytes{memoryMegabytes}
+    {}
+
+    /**
+     * @brief Prepares a Bleach file, so it can be run on request.
+     *
+     * @param filePath The path to the Bleach file. Requests refer to the file by this exact path.
+     *
+     * @return 0 if the file has been prepared, 65 if it has a static error or 74 if it could not be read.
+    **/
+    int prepare(const std::string& filePath){
+      std::string sourceCode;
+      if(!readSourceFile(filePath, sourceCode)){
+        return 74;
+      }
+
+      PreparedScript script{std::make_unique<Interpreter>(), nullptr};
+      script.program = compileProgram(*script.interpreter, sourceCode);
+      if(script.program == nullptr){
+        return 65;
+      }
+      scripts[filePath] = std::move(script);
+
+      return 0;
+    }
+
+    /**
+     * @brief Starts up the server and handles requests until the process is killed.
+     *
+     * @return 0 if the server has stopped normally or 74 if the socket could not be set up.
+    **/
+    int serve(){
+      int listener = listenOn(socketPath);
+      if(listener < 0){
+        return 74;
+      }
+
+      std::cerr << "[BLEACH Fork Server]: " << scripts.size() << " scripts prepared. Listening on '" << socketPath << "'." << std::endl;
+
+      for(;;){
+        int connection = acceptConnection(listener);
+        if(connection < 0){
+          break;
+        }
+
+        handle(listener, connection);
+        close(connection);
+      }
+
+      close(listener);
+      unlink(socketPath.c_str());
+
+      return 0;
+    }
+};
+
+/**
+ * @brief Starts up the BLEACH Interpreter in the "Fork Server Mode" (see the ForkServer class). The usage is:
+ *
+ *   ./BleachInterpreter --fork-server path/to.sock [--cpu SECONDS] [--timeout SECONDS] [--memory MEGABYTES] file1.bch file2.bch ...
+ *
+ * The CPU time limit and the wall-clock time limit of each child default to 10 seconds (a value of 0 also
+ * means the default).
+ *
+ * @param arguments The arguments that follow "--fork-server" in the command line.
+ *
+ * @return The exit status of the server: 64 if the command line is invalid, 65 or 74 if some file could not be
+ * prepared, 0 otherwise.
+**/
+inline int runForkServer(const std::vector<std::string>& arguments){
+  if(arguments.empty()){
+    std::cerr << RED << "[BLEACH Interpreter Error]: The '--fork-server' mode expects the path of a socket." << WHITE << std::endl;
+    return 64;
+  }
+
+  const unsigned int defaultSeconds = 10;
+  rlim_t cpuSeconds = defaultSeconds, memoryMegabytes = 0;
+  unsigned int timeoutSeconds = defaultSeconds;
+  std::vector<std::string> filePaths;
+  for(int i = 1; i < arguments.size(); i++){
+    if(arguments[i] == "--cpu" && i + 1 < arguments.size()){
+      cpuSeconds = std::strtoull(arguments[++i].c_str(), nullptr, 10);
+      if(cpuSeconds == 0){
+        cpuSeconds = defaultSeconds;
+      }
+    }else if(arguments[i] == "--timeout" && i + 1 < arguments.size()){
+      timeoutSeconds = static_cast<unsigned int>(std::strtoul(arguments[++i].c_str(), nullptr, 10));
+      if(timeoutSeconds == 0){
+        timeoutSeconds = defaultSeconds;
+      }
+    }else if(arguments[i] == "--memory" && i + 1 < arguments.size()){
+      memoryMegabytes = std::strtoull(arguments[++i].c_str(), nullptr, 10);
+    }else{
+      filePaths.push_back(arguments[i]);
+    }
+  }
+
+  ForkServer server{arguments[0], cpuSeconds, timeoutSeconds, memoryMegabytes};
+  for(const std::string& filePath : filePaths){
+    int status = server.prepare(filePath);
+    if(status != 0){
+      return status;
+    }
+  }
+
+  return server.serve();
+}
@@ -0,0 +1,285 @@
+#pragma once
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../error/Error.hpp"
+#include "../interpreter/Interpreter.hpp"
+#include "../lexer/Lexer.hpp"
+#include "../parser/Parser.hpp"
+#include "../resolver/Resolver.hpp"
+
+
+/**
+ * @struct ScriptResult
+ * 
+ * @brief Stores the result of the execution of a Bleach program that was run in isolation: What it has written
+ * to its output and error streams, its exit status and how long it took to run.
+ *
+ * The exit status follows the same convention of the "File Mode" of the BLEACH Interpreter: 0 means success, 
+ * 65 means that a static error has happened, 70 means that a runtime error has happened and 74 means that the 
+ * Bleach file could not be read.
+**/
+struct ScriptResult{
+  std::string output; /**< Variable that stores everything the program has written to its output stream. */
+  std::string errors; /**< Variable that stores everything the program has written to its error stream. */
+  int exitStatus = 0; /**< Variable that stores the exit status of the program. */
+  double milliseconds = 0; /**< Variable that stores how long (wall-clock time) the program took to run. */
+};
+
+/**
+ * @brief Receives a path to a file (absolute or relative), checks whether the file exists and if it is a Bleach
+ * file, extracts all of its content and stores it in a string.
+ * 
+ * This function is responsible for receiving the absolute of relative file path of a supposed Bleach file. 
+ * Then, it checks whether the file exists and whether it is, indeeed, a Bleach file. If everything went okay, 
+ * then this function stores the whole content of the file inside the "fileContent" parameter. Otherwise, it 
+ * reports the problem to the current error stream.
+ * 
+ * @param filePath A string (std::string_view) that stores the absolute or relative file path to the Bleach file.
+ * @param fileContent The string (std::string) that receives the content (source code) of the file.
+ * 
+ * @return A boolean that tells whether the file could be read.
+**/
+inline bool readSourceFile(std::string_view filePath, std::string& fileContent){
+  std::filesystem::path path{filePath};
+  if(path.extension() != ".bch"){
+    *errorStream << RED << "[BLEACH Interpreter Error]: Cannot execute the provided file because it's not a Bleach file: '" << filePath << "'. " << WHITE << std::endl;
+    return false;
+  }
+
+  std::ifstream file{std::string{filePath}, std::ios::in | std::ios::binary | std::ios::ate};
+  if(!file){
+    *errorStream << RED << "[BLEACH Interpreter Error]: Failed to open file '" << filePath << "': " << std::strerror(errno) << WHITE << std::endl;
+    return false;
+  }
+
+  fileContent.resize(file.tellg());
+
+  file.seekg(0, std::ios::beg);
+  file.read(fileContent.data(), fileContent.size());
+  file.close();
+
+  return true;
+}
+
+/**
+ * @brief Lexes, parses and resolves the source code of a Bleach program, returning its AST (Abstract Syntax 
+ * Tree). If a static error is found, an empty list of statements is returned and "hadError" is set.
+ * If the program declares a function or a lambda function, its source code is recorded inside the "sources" 
+ * attribute of the interpreter (snapshots need it), unless the same source code has already been recorded.
+ * 
+ * @param interpreter The instance of the Interpreter class that will execute the program. The references to 
+ * global variables are resolved against its global environment.
+ * @param sourceCode A string (std::string_view) that contains the source code of a Bleach program.
+ * 
+ * @return The list of statements of the program.
+**/
+inline std::vector<std::shared_ptr<Stmt>> compileSource(Interpreter& interpreter, std::string_view sourceCode){
+  /* First Step: Lexing */
+  Lexer lexer{sourceCode};
+  std::vector<Token> tokens = lexer.lexTokens();
+
+  if(hadError){
+    return {};
+  }
+
+  /* Second Step: Parsing */
+  Parser parser{tokens};
+  std::vector<std::shared_ptr<Stmt>> statements = parser.parse();
+
+  if(hadError){
+    return {};
+  }
+
+  /* Third Step: Resolving */
+  int declarationCount = interpreter.declarationCount;
+  auto recorded = interpreter.sourceDeclarations.find(std::string{sourceCode});
+  if(recorded != interpreter.sourceDeclarations.end() && !interpreter.restoringSnapshot){
+    interpreter.replayedDeclaration = recorded->second;
+  }
+  Resolver resolver{interpreter};
+  resolver.resolve(statements);
+  interpreter.replayedDeclaration = -1;
+
+  if(hadError){
+    interpreter.declarationCount = declarationCount; // The declarations of a program that will not run must not be numbered.
+    return {};
+  }
+  if(interpreter.declarationCount != declarationCount){
+    interpreter.sources.emplace_back(sourceCode);
+    interpreter.sourceDeclarations.emplace(sourceCode, declarationCount);
+  }
+
+  return statements;
+}
+
+/**
+ * @brief Lexes, parses, resolves and executes the source code of a Bleach program.
+ * 
+ * This function is responsible for performing each step of the interpreter pipeline and, if an error is found 
+ * during one of these steps, then the whole process is interrupted.
+ * 
+ * @param interpreter The instance of the Interpreter class that executes the program.
+ * @param sourceCode A string (std::string_view) that contains the source code of a Bleach program.
+ * 
+ * @return Nothing (void).
+**/
+inline void runSource(Interpreter& interpreter, std::string_view sourceCode){
+  std::vector<std::shared_ptr<Stmt>> statements = compileSource(interpreter, sourceCode);
+
+  if(hadError){
+    return;
+  }
+
+  /* Fourth Step: Interpreting */
+  interpreter.interpret(statements);
+
+  return;
+}
+
+/**
+ * @struct CompiledProgram
+ * 
+ * @brief Stores the AST of a Bleach program that has already been lexed, parsed and resolved, so it can be run
+ * many times without being compiled again.
+ *
+ * The references to global variables of the AST are bound to slots of the global environment of the instance 
+ * of the Interpreter class that has resolved it. Therefore, the names of the global variables of such instance 
+ * (ordered by their slots) are also stored: By replaying them on another instance (see the "bindGlobals" 
+ * function), the AST can be run by it as well.
+ * The same goes for the numbers given to its function and lambda function declarations: The sources and the 
+ * amount of declarations of such instance are stored as well, so a snapshot taken by the other instance can 
+ * number them back when it is restored.
+**/
+struct CompiledProgram{
+  std::vector<std::shared_ptr<Stmt>> statements; /**< Variable that stores the statements of the program. */
+  std::vector<std::string> globalNames; /**< Variable that stores the names of the global variables, ordered by their slots. */
+  std::vector<std::string> sources; /**< Variable that stores the sources recorded by the instance that has resolved the program (see the "sources" attribute of the Interpreter class). */
+  int declarationCount = 0; /**< Variable that stores how many declarations had been resolved against such instance. */
+};
+
+/**
+ * @brief Lexes, parses and resolves the source code of a Bleach program into an instance of the CompiledProgram
+ * struct. If a static error is found, nullptr is returned (and the error is reported to the error stream).
+ * 
+ * @param interpreter A fresh instance of the Interpreter class, against which the program is resolved.
+ * @param sourceCode A string (std::string_view) that contains the source code of a Bleach program.
+ * 
+ * @return The compiled program or nullptr.
+**/
+inline std::shared_ptr<CompiledProgram> compileProgram(Interpreter& interpreter, std::string_view sourceCode){
+  std::vector<std::shared_ptr<Stmt>> statements = compileSource(interpreter, sourceCode);
+
+  if(hadError){
+    return nullptr;
+  }
+
+  return std::make_shared<CompiledProgram>(CompiledProgram{std::move(statements), interpreter.globals->slotNames(), interpreter.sources, interpreter.declarationCount});
+}
+
+/**
+ * @brief Prepares a fresh instance of the Interpreter class to run a program that was compiled by another 
+ * instance, reproducing the layout of the global environment of the latter and the numbering of its 
+ * declarations (so snapshots taken while the program runs can be restored).
+ * 
+ * @param interpreter A fresh instance of the Interpreter class.
+ * @param program The compiled program.
+ * 
+ * @return A boolean that tells whether the layout could be reproduced. If it is false, the program must be 
+ * compiled again by the received instance.
+**/
+inline bool bindGlobals(Interpreter& interpreter, const CompiledProgram& program){
+  if(interpreter.declarationCount != 0){ // The declarations already resolved against the instance would clash with the ones of the program.
+    return false;
+  }
+  for(int i = 0; i < program.globalNames.size(); i++){
+    if(interpreter.globals->slotOf(program.globalNames[i]) != i){
+      return false;
+    }
+  }
+  interpreter.sources = program.sources;
+  interpreter.declarationCount = program.declarationCount;
+
+  return true;
+}
+
+/**
+ * @brief Runs a piece of work with the output and error streams of the current thread captured in memory and 
+ * with fresh error flags, returning what it has produced.
+ * 
+ * @param work The work to be run. It returns the exit status (0, 65, 70 or 74) of the program it runs.
+ * 
+ * @return An instance of the ScriptResult struct.
+**/
+template<typename Work>
+ScriptResult runCaptured(Work&& work){
+  ScriptResult result;
+  std::ostringstream output;
+  std::ostringstream errors;
+  auto start = std::chrono::steady_clock::now();
+
+  outputStream = &output;
+  errorStream = &errors;
+  hadError = false;
+  hadRuntimeError = false;
+
+  try{
+    result.exitStatus = work();
+  }catch(const std::exception& exception){ // An unexpected failure must not bring down the other programs that are being run.
+    *errorStream << RED << "[BLEACH Interpreter Error]: Internal error: " << exception.what() << WHITE << std::endl;
+    result.exitStatus = 70;
+  }
+
+  outputStream = &std::cout;
+  errorStream = &std::cerr;
+
+  result.output = output.str();
+  result.errors = errors.str();
+  result.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+  return result;
+}
+
+/**
+ * @brief Returns the exit status of the program that has just been run, according to the error flags.
+ * 
+ * @return 65 if a static error has happened, 70 if a runtime error has happened and 0 otherwise.
+**/
+inline int exitStatus(){
+  return hadError ? 65 : (hadRuntimeError ? 70 : 0);
+}
+
+/**
+ * @brief Runs a Bleach file in isolation and returns what it has produced.
+ * 
+ * This function is responsible for running a Bleach file inside a fresh instance of the Interpreter class (an 
+ * "isolate"), with its output and error streams captured in memory and with its own error flags. Since such 
+ * state is thread local, several Bleach files can be run at the same time by different threads.
+ * 
+ * @param filePath The absolute or relative path to the Bleach file.
+ * 
+ * @return An instance of the ScriptResult struct.
+**/
+inline ScriptResult runIsolated(std::string_view filePath){
+  return runCaptured([&](){
+    std::string sourceCode;
+    if(!readSourceFile(filePath, sourceCode)){
+      return 74;
+    }
+
+    Interpreter isolate{};
+    runSource(isolate, sourceCode);
+
+    return exitStatus();
+  });
+}
@@ -0,0 +1,299 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "./Runner.hpp"
+#include "./Socket.hpp"
+
+
+/**
+ * @class Server
+ *
+ * @brief This class is responsible for implementing the "Server Mode" of the BLEACH Interpreter: A long-lived
+ * process that runs Bleach programs on request, received through a Unix domain socket.
+ *
+ * Each connection carries a single request, whose first line
+ * is either "RUN <length>" (followed by exactly <length> bytes of Bleach source code) or "FILE <path>" (the path
+ * to a Bleach file, read by the server). The response has three parts, written in this order:
+ *
+ *   STDOUT <length>\n<bytes written by the program to its output stream>
+ *   STDERR <length>\n<bytes written by the program to its error stream>
+ *   EXIT <exit status> <milliseconds>\n
+ *
+ * After that, the connection is closed. The exit status follows the convention of the "File Mode".
+ * Every program runs in its own isolate (an instance of the Interpreter class), so nothing leaks from one
+ * request to the next. The next isolate is always built right after a response is sent, off the critical path
+ * of the next request. Compiled programs (see the CompiledProgram struct) are cached by their source code, so
+ * a program that has been seen before is neither lexed, nor parsed, nor resolved again.
+ *
+ * Programs run one at a time, on the thread that called the "serve" method. Connections are read and written by
+ * a fixed pool of "connectionWorkers" threads, so a client that is slow to send its request (or to read its
+ * response) does not delay the programs of the other clients. At most "maxPendingConnections" connections wait
+ * for a worker: Any other connection is answered with "ERROR server busy". Requests whose header or body is too
+ * long (see the "readRequest" function) are answered with "ERROR request too large". Each program has a wall-clock time limit (see the "deadline" variable of the Interpreter class), and
+ * the standard input of the server is "/dev/null", so no program can hold up the ones that come after it.
+ *
+ * @note: The cache keeps up to "cacheCapacity" programs. When it is full, an arbitrary program is dropped.
+**/
+class Server{
+  private:
+    static constexpr std::size_t cacheCapacity = 256; /**< Variable that stores the maximum amount of cached programs. */
+    static constexpr std::size_t connectionWorkers = 16; /**< Variable that stores the amount of threads that read requests and write responses. */
+    static constexpr std::size_t maxPendingConnections = 64; /**< Variable that stores the maximum amount of accepted connections that wait for a worker. */
+
+    /**
+     * @struct Request
+     *
+     * @brief Stores a request that has been completely read, along with the promise through which its response
+     * is handed back to the thread of its connection.
+    **/
+    struct Request{
+      std::string header;
+      std::string body;
+      std::promise<std::string> response;
+    };
+
+    /**
+     * @struct RequestQueue
+     *
+     * @brief Stores the connections that are waiting for a worker and the requests that are waiting to be run,
+     * each in the order in which they have arrived.
+    **/
+    struct RequestQueue{
+      std::mutex mutex;
+      std::condition_variable connectionReady; // Signaled when a connection is queued (or the server stops accepting them).
+      std::condition_variable ready; // Signaled when a request is queued (or a worker becomes idle).
+      std::deque<int> connections;
+      std::deque<Request> requests;
+      std::size_t busyWorkers = 0; // Workers that are serving a connection.
+      bool closed = false; // Set when the server can no longer accept connections.
+    };
+
+    const std::string socketPath; /**< Variable that stores the path of the Unix domain socket. */
+    const std::chrono::milliseconds timeout; /**< Variable that stores the wall-clock time limit of each program. */
+    std::unordered_map<std::string, std::shared_ptr<CompiledProgram>> cache; /**< Variable that maps source code to its compiled program. */
+    std::unique_ptr<Interpreter> isolate; /**< Variable that stores the isolate that will run the next request. */
+
+    /**
+     * @brief Runs the received source code in the current isolate, reusing its compiled program when it is
+     * cached.
+     *
+     * @param sourceCode The source code of a Bleach program.
+     *
+     * @return The exit status of the program.
+    **/
+    int execute(const std::string& sourceCode){
+      std::shared_ptr<CompiledProgram> program;
+      auto elem = cache.find(sourceCode);
+      if(elem != cache.end() && bindGlobals(*isolate, *elem->second)){
+        program = elem->second;
+      }else{
+        program = compileProgram(*isolate, sourceCode);
+        if(program == nullptr){
+          return exitStatus();
+        }
+        if(cache.size() >= cacheCapacity){
+          cache.erase(cache.begin());
+        }
+        cache[sourceCode] = program;
+      }
+
+      isolate->deadline = std::chrono::steady_clock::now() + timeout;
+      isolate->interpret(program->statements);
+
+      return exitStatus();
+    }
+
+    /**
+     * @brief Serves a single connection: Reads the request, queues it, waits for its response and writes it.
+     *
+     * @param queue The queue of the requests that are waiting to be run.
+     * @param connection The file descriptor of the connection (closed before this function returns).
+     *
+     * @return Nothing (void).
+    **/
+    static void serveConnection(RequestQueue& queue, int connection){
+      Request request;
+      RequestStatus status = readRequest(connection, request.header, request.body);
+      if(status == RequestStatus::TOO_LARGE){
+        writeAll(connection, "ERROR request too large\n");
+        close(connection);
+        return;
+      }
+      if(status != RequestStatus::COMPLETE || (request.header.rfind("RUN ", 0) != 0 && request.header.rfind("FILE ", 0) != 0)){
+        writeAll(connection, "ERROR malformed request\n");
+        close(connection);
+        return;
+      }
+
+      std::future<std::string> response = request.response.get_future();
+      {
+        std::lock_guard<std::mutex> lock{queue.mutex};
+        queue.requests.push_back(std::move(request));
+      }
+      queue.ready.notify_one();
+
+      writeAll(connection, response.get());
+      close(connection);
+
+      return;
+    }
+
+    /**
+     * @brief Runs a worker of the pool: Serves the queued connections, one at a time, until the server stops
+     * accepting them.
+     *
+     * @param queue The queue of the connections that are waiting for a worker.
+     *
+     * @return Nothing (void).
+    **/
+    static void runWorker(RequestQueue& queue){
+      for(;;){
+        int connection;
+        {
+          std::unique_lock<std::mutex> lock{queue.mutex};
+          queue.connectionReady.wait(lock, [&](){ return !queue.connections.empty() || queue.closed; });
+          if(queue.connections.empty()){
+            return;
+          }
+          connection = queue.connections.front();
+          queue.connections.pop_front();
+          queue.busyWorkers++;
+        }
+
+        serveConnection(queue, connection);
+
+        {
+          std::lock_guard<std::mutex> lock{queue.mutex};
+          queue.busyWorkers--;
+        }
+        queue.ready.notify_one(); // The server stops once every worker is idle (see the "serve" method).
+      }
+    }
+
+    /**
+     * @brief Handles a single request: Runs the program and returns the response.
+     *
+     * @param header The first line of the request.
+     * @param body The bytes that follow the first line.
+     *
+     * @return The response.
+    **/
+    std::string handle(const std::string& header, const std::string& body){
+      ScriptResult result = runCaptured([&](){
+        if(header.rfind("FILE ", 0) == 0){
+          std::string sourceCode;
+          if(!readSourceFile(header.substr(5), sourceCode)){
+            return 74;
+          }
+          return execute(sourceCode);
+        }
+        return execute(body);
+      });
+
+      return "STDOUT " + std::to_string(result.output.size()) + "\n" + result.output
+        + "STDERR " + std::to_string(result.errors.size()) + "\n" + result.errors
+        + "EXIT " + std::to_string(result.exitStatus) + " " + std::to_string(result.milliseconds) + "\n";
+    }
+
+  public:
+    /**
+     * @brief Constructs a Server that listens on the received path.
+     *
+     * @param socketPath The path of the Unix domain socket. If a file already exists there, it's replaced.
+     * @param timeout The wall-clock time limit of each program.
+    **/
+    Server(std::string socketPath, std::chrono::milliseconds timeout)
+      : socketPath{std::move(socketPath)}, timeout{timeout}
+    {}
+
+    /**
+     * @brief Starts up the server and handles requests until the process is killed.
+     *
+     * @return 0 if the server has stopped normally or 74 if the socket could not be set up.
+    **/
+    int serve(){
+      int listener = listenOn(socketPath);
+      if(listener < 0){
+        return 74;
+      }
+
+      int input = open("/dev/null", O_RDONLY); // Programs must not read (or wait for) the standard input of the server.
+      if(input >= 0){
+        dup2(input, STDIN_FILENO);
+        close(input);
+      }
+
+      std::cerr << "[BLEACH Server]: Listening on '" << socketPath << "'." << std::endl;
+
+      RequestQueue queue;
+      std::vector<std::thread> workers;
+      for(std::size_t i = 0; i < connectionWorkers; i++){
+        workers.emplace_back(runWorker, std::ref(queue));
+      }
+
+      std::thread acceptor{[&queue, listener](){
+        for(;;){
+          int connection = acceptConnection(listener);
+          if(connection < 0){
+            break;
+          }
+
+          std::unique_lock<std::mutex> lock{queue.mutex};
+          if(queue.connections.size() >= maxPendingConnections){
+            lock.unlock();
+            writeAll(connection, "ERROR server busy\n");
+            close(connection);
+            continue;
+          }
+          queue.connections.push_back(connection);
+          lock.unlock();
+          queue.connectionReady.notify_one();
+        }
+
+        std::lock_guard<std::mutex> lock{queue.mutex};
+        queue.closed = true;
+        queue.connectionReady.notify_all();
+        queue.ready.notify_one();
+      }};
+
+      isolate = std::make_unique<Interpreter>();
+      for(;;){
+        Request request;
+        {
+          std::unique_lock<std::mutex> lock{queue.mutex};
+          queue.ready.wait(lock, [&](){ return !queue.requests.empty() || (queue.closed && queue.connections.empty() && queue.busyWorkers == 0); });
+          if(queue.requests.empty()){
+            break;
+          }
+          request = std::move(queue.requests.front());
+          queue.requests.pop_front();
+        }
+
+        request.response.set_value(handle(request.header, request.body));
+        isolate = std::make_unique<Interpreter>(); // The isolate for the next request.
+      }
+
+      acceptor.join();
+      for(std::thread& worker : workers){
+        worker.join();
+      }
+      close(listener);
+      unlink(socketPath.c_str());
+
+      return 0;
+    }
+};
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "../error/Error.hpp"
+
+
+/**
+ * @brief Creates a Unix domain socket bound to the received path and starts listening on it. If a file already
+ * exists at such path, it's replaced.
+ *
+ * @param socketPath The path of the Unix domain socket.
+ *
+ * @return The file descriptor of the socket or -1 if it could not be set up (the problem is reported to the
+ * standard error).
+**/
+inline int listenOn(const std::string& socketPath){
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  if(socketPath.size() >= sizeof(address.sun_path)){
+    std::cerr << RED << "[BLEACH Interpreter Error]: The socket path '" << socketPath << "' is too long." << WHITE << std::endl;
+    return -1;
+  }
+  std::strcpy(address.sun_path, socketPath.c_str());
+
+  int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+  unlink(socketPath.c_str());
+  if(listener < 0 || bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || listen(listener, 64) < 0){
+    std::cerr << RED << "[BLEACH Interpreter Error]: Failed to listen on '" << socketPath << "': " << std::strerror(errno) << WHITE << std::endl;
+    return -1;
+  }
+
+  std::signal(SIGPIPE, SIG_IGN); // A client that goes away must not kill the process.
+
+  return listener;
+}
+
+/**
+ * @brief Waits for the next connection on the received socket.
+ *
+ * @param listener The file descriptor of a socket created by the "listenOn" function.
+ *
+ * @return The file descriptor of the connection or -1 if the socket can no longer accept connections.
+**/
+inline int acceptConnection(int listener){
+  for(;;){
+    int connection = accept(listener, nullptr, nullptr);
+    if(connection < 0){
+      if(errno == EINTR){
+        continue;
+      }
+      return -1;
+    }
+
+    timeval timeout{5, 0}; // A client that stops sending must not stall the process.
+    setsockopt(connection, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    return connection;
+  }
+}
+
+/**
+ * @enum RequestStatus
+ *
+ * @brief Enumerates the outcomes of reading a request (see the "readRequest" function).
+**/
+enum class RequestStatus{
+  COMPLETE, // The whole request has been read.
+  INCOMPLETE, // The client has closed the connection (or stopped sending) before the end of the request.
+  TOO_LARGE, // The header line or the body is longer than allowed.
+};
+
+inline constexpr std::size_t maxHeaderLength = 4096; /**< Variable that stores the maximum length of the first line of a request (without the line break). */
+inline constexpr std::size_t maxBodyLength = 16 << 20; /**< Variable that stores the maximum length of the body of a request. */
+
+/**
+ * @brief Reads a request from the received connection: A header line and, if the header is "RUN <length>",
+ * exactly <length> bytes after it.
+ *
+ * @param connection The file descriptor of the connection.
+ * @param header The string that receives the first line of the request (without the line break).
+ * @param body The string that receives the bytes that follow the first line.
+ *
+ * @return Whether a complete request has been read (see the RequestStatus enum). Requests whose header is
+ * longer than "maxHeaderLength" bytes or whose body is longer than "maxBodyLength" bytes are not read to the end.
+**/
+inline RequestStatus readRequest(int connection, std::string& header, std::string& body){
+  char buffer[4096];
+  std::string data;
+  std::size_t newline;
+  while((newline = data.find('\n')) == std::string::npos){
+    if(data.size() > maxHeaderLength){
+      return RequestStatus::TOO_LARGE;
+    }
+    ssize_t count = read(connection, buffer, sizeof(buffer));
+    if(count <= 0){
+      return RequestStatus::INCOMPLETE;
+    }
+    data.append(buffer, count);
+  }
+  if(newline > maxHeaderLength){
+    return RequestStatus::TOO_LARGE;
+  }
+
+  header = data.substr(0, newline);
+  body = data.substr(newline + 1);
+  if(header.rfind("RUN ", 0) != 0){
+    return RequestStatus::COMPLETE;
+  }
+
+  errno = 0;
+  std::size_t length = std::strtoull(header.c_str() + 4, nullptr, 10);
+  if(errno == ERANGE || length > maxBodyLength){
+    return RequestStatus::TOO_LARGE;
+  }
+  body.reserve(length);
+  while(body.size() < length){
+    ssize_t count = read(connection, buffer, sizeof(buffer));
+    if(count <= 0){
+      return RequestStatus::INCOMPLETE;
+    }
+    body.append(buffer, count);
+  }
+  body.resize(length);
+
+  return RequestStatus::COMPLETE;
+}
+
+/**
+ * @brief Writes the whole content of the received string to the received connection.
+ *
+ * @param connection The file descriptor of the connection.
+ * @param data The bytes to be written.
+ *
+ * @return Nothing (void).
+**/
+inline void writeAll(int connection, const std::string& data){
+  std::size_t written = 0;
+  while(written < data.size()){
+    ssize_t count = write(connection, data.data() + written, data.size() - written);
+    if(count <= 0){
+      return;
+    }
+    written += count;
+  }
+
+  return;
+}
@@ -4,6 +4,8 @@
 #include <string>
 #include <vector>
 
+#include "./ValueStack.hpp"
+
 
 class Interpreter; // Forward declaration necessary to implement the BleachCallable class.
 class Token; // Forward declaration necessary to implement the BleachCallable class.
@@ -25,8 +27,8 @@ class Token; // Forward declaration necessary to implement the BleachCallable cl
 class BleachCallable{
   public:
     virtual int arity() = 0; // Returns the expected number of arguments of the callable.
-    virtual std::any call(Interpreter& interpreter, std::vector<std::any> arguments) = 0; // To deal with Bleach Classes, Bleach Functions and Bleach Lambda Functions.
-    virtual std::any call(Interpreter& interpreter, Token paren, std::vector<std::any> arguments) = 0; // To deal with Bleach Native Functions.
+    virtual std::any call(Interpreter& interpreter, ArgumentSpan arguments) = 0; // To deal with Bleach Classes, Bleach Functions and Bleach Lambda Functions.
+    virtual std::any call(Interpreter& interpreter, const Token& paren, ArgumentSpan arguments) = 0; // To deal with Bleach Native Functions.
     virtual std::string toString() = 0; // Returns the string representation of the callable.
     virtual ~BleachCallable() = default;
 };
@@ -1,13 +1,19 @@
 #include <utility>
 
 #include "./BleachClass.hpp"
+#include "./Stmt.hpp"
+#include "./Streams.hpp"
+#include "./SymbolTable.hpp"
 
 
 /**
  * @brief Constructs a BleachClass object. 
  *
  * This constructor initializes a BleachClass object with the three attributes that were mentioned inside the
- * "BleachClass.hpp" file.
+ * "BleachClass.hpp" file. Then, it finalizes the class: It copies down the method table of the superclass (if 
+ * any), adds the methods declared by this class on top of it (so overriding methods replace inherited ones),
+ * caches the "init" method and computes the layout of its instances (the layout of the superclass followed by
+ * the fields that are only assigned by the "init" method of this class).
  *
  * @param name: The name of the user-defined class.
  * @param superclass: The superclass from which the class inherits methods. Pay attention to the fact that not
@@ -15,10 +21,100 @@
  * @param methods: The map that stores key-value pairs where, in each pair, the key is the name of a method that
  * was declared inside the class declaration and the value is the BleachFunction that represents such method
  * during runtime.
+ * @param fieldIds: The interned IDs of the fields that the "init" method of the class assigns to "self". They
+ * are found by the Resolver.
 **/
-BleachClass::BleachClass(std::string name, std::shared_ptr<BleachClass> superclass, std::map<std::string, std::shared_ptr<BleachFunction>> methods)
+BleachClass::BleachClass(std::string name, std::shared_ptr<BleachClass> superclass, std::map<std::string, std::shared_ptr<BleachFunction>> methods, const std::vector<int>& fieldIds)
   : name{std::move(name)}, superclass{std::move(superclass)}, methods{std::move(methods)}
-{}
+{
+  static const int initId = SymbolTable::intern("init");
+
+  if(this->superclass != nullptr){
+    methodTable = this->superclass->methodTable; // The superclass has already been finalized, so its table already contains every method it inherits.
+  }
+  for(const auto& [methodName, method] : this->methods){
+    methodTable[SymbolTable::intern(methodName)] = method;
+  }
+
+  initializer = findMethod(initId);
+
+  if(this->superclass != nullptr){
+    fieldSlots = this->superclass->fieldSlots;
+    fieldCount = this->superclass->fieldCount;
+  }
+  for(int fieldId : fieldIds){
+    if(fieldSlots.find(fieldId) == fieldSlots.end()){
+      fieldSlots[fieldId] = fieldCount++;
+    }
+  }
+
+  analyzeInitializer();
+}
+
+/**
+ * @brief Checks whether the "init" method of the class is simple and, if that's the case, records the 
+ * assignments it performs.
+ * 
+ * This method is responsible for checking whether every statement inside the body of the "init" method of the
+ * class (declared or inherited) has the form "self.field = parameter;" or "self.field = literal;", where the 
+ * parameter is one of the parameters of the "init" method. Such initializers are very common in small classes
+ * (points, pairs, nodes). If that's the case, the "init" method does not need to be executed when an instance
+ * is created: The arguments of the call can be stored straight into the slots of the instance.
+ * This only elides the execution of the "init" method. Every instance is still allocated, whether or not it 
+ * escapes the function that creates it.
+ * 
+ * @return Nothing (void).
+**/
+void BleachClass::analyzeInitializer(){
+  if(initializer == nullptr){
+    return;
+  }
+
+  const std::shared_ptr<Function>& declaration = initializer->functionDeclaration;
+  std::vector<FieldInitializer> assignments;
+
+  for(const std::shared_ptr<Stmt>& statement : declaration->body){
+    if(statement->kind != StmtKind::EXPRESSION){
+      return;
+    }
+    const std::shared_ptr<Expr>& expression = std::static_pointer_cast<Expression>(statement)->expression;
+    if(expression->kind != ExprKind::SET){
+      return;
+    }
+    auto set = std::static_pointer_cast<Set>(expression);
+    if(set->object->kind != ExprKind::SELF){
+      return;
+    }
+
+    int slot = findFieldSlot(set->nameId); // Every field assigned to "self" inside the "init" method is part of the layout of the class.
+    if(slot == -1){
+      return;
+    }
+
+    if(set->value->kind == ExprKind::LITERAL){
+      assignments.push_back(FieldInitializer{slot, -1, std::static_pointer_cast<Literal>(set->value)->value});
+    }else if(set->value->kind == ExprKind::VARIABLE){
+      const std::string& variableName = std::static_pointer_cast<Variable>(set->value)->name.lexeme;
+      int parameter = -1;
+      for(int i = 0; i < declaration->parameters.size(); i++){
+        if(declaration->parameters[i].lexeme == variableName){
+          parameter = i;
+        }
+      }
+      if(parameter == -1){ // The variable is not a parameter of the "init" method.
+        return;
+      }
+      assignments.push_back(FieldInitializer{slot, parameter, {}});
+    }else{
+      return;
+    }
+  }
+
+  hasSimpleInitializer = true;
+  simpleInitializer = std::move(assignments);
+
+  return;
+}
 
 /**
  * @brief Returns the arity of the instance from the BleachClass class. 
@@ -35,8 +131,6 @@ BleachClass::BleachClass(std::string name, std::shared_ptr<BleachClass> supercla
  * every class doesn't expect any arguments.
 **/
 int BleachClass::arity(){
-  std::shared_ptr<BleachFunction> initializer = findMethod("init");
-  
   if(initializer != nullptr){
     return initializer->arity();
   }
@@ -59,12 +153,15 @@ int BleachClass::arity(){
  * @return An instance of the BleachInstance class. Such instance represents the object that was created given
  * the list of arguments to its constructor (which is, behind the scenes, this method).
 **/
-std::any BleachClass::call(Interpreter& interpreter, std::vector<std::any> arguments){ // className()
+std::any BleachClass::call(Interpreter& interpreter, ArgumentSpan arguments){ // className()
   auto instance = std::make_shared<BleachInstance>(shared_from_this()); // Creates an instance of the class.
-  std::shared_ptr<BleachFunction> initializer = findMethod("init"); // Search for the "init" method, which is a constructor. A value of type std::shared_ptr<BleachFunction>.
 
-  if(initializer != nullptr){ // If the initializer (std::shared_ptr<BleachFunction>) of the class has been found.
-    initializer->bind(instance)->call(interpreter, std::move(arguments)); // Calling the constructor in the instance.
+  if(hasSimpleInitializer){ // If the initializer only assigns parameters and literals to fields, then there's no need to execute it.
+    for(const FieldInitializer& assignment : simpleInitializer){
+      instance->slots[assignment.slot] = (assignment.parameter == -1) ? assignment.literal : arguments[assignment.parameter];
+    }
+  }else if(initializer != nullptr){ // If the class has an initializer ("init" method), which is a constructor. It was cached when the class was finalized.
+    initializer->call(interpreter, instance, std::move(arguments)); // Calling the constructor in the instance.
   }
   
   return instance; // Returning the instance after all this process is executed.
@@ -74,8 +171,8 @@ std::any BleachClass::call(Interpreter& interpreter, std::vector<std::any> argum
  * @note: This overloaded version of the 'call' method is restricted to be used when calling Bleach native 
  * functions. It won't be called by an instance of a BleachClass class.
 **/
-std::any BleachClass::call(Interpreter& interpreter, Token paren, std::vector<std::any> arguments){
-  std::cout << "No implementation of this method available for the 'BleachClass' class." << std::endl;
+std::any BleachClass::call(Interpreter& interpreter, const Token& paren, ArgumentSpan arguments){
+  *outputStream << "No implementation of this method available for the 'BleachClass' class." << std::endl;
  
   return {};
 }
@@ -86,34 +183,57 @@ std::any BleachClass::call(Interpreter& interpreter, Token paren, std::vector<st
  * method returns a nullptr.
  * 
  * This method is responsible for receiving a string representing the name of a possible method of a class.
- * Then, this method searches for the required method in its "methods" map and returns the runtime 
- * representation of the method (a BleachFunction). If the method is not found in the "methods" map of the 
- * class, then the search continues in a recursive manner following the chain of superclasses, if any. If the 
- * method is not found in the class and not in the chain of superclasses, then it returns a nullptr.
+ * Then, it interns such name and searches for the required method in the flattened method table of the class.
  * 
  * @param name: The name of the required method.
  * 
- * @return The runtime representation of the method that is associated to the string "name" inside the "methods"
- * map of the class or inside the "methods" map inside any of the classes along the chain of superclasses (if
- * any).
+ * @return The runtime representation of the method that is associated to the string "name" inside the class
+ * or inside any of the classes along the chain of superclasses (if any).
  * 
  * @note: If the runtime representation of the method whose name was received as an argument is not found inside
- * the "methods" map of the class or inside the "methods" map inside any of the classes along the chain of
- * superclasses (if any), then this method returns a nullptr.
+ * the class or inside any of the classes along the chain of superclasses (if any), then this method returns a
+ * nullptr.
 **/
 std::shared_ptr<BleachFunction> BleachClass::findMethod(const std::string& name){
-  // First, we search for the method inside the current class.
-  auto elem = methods.find(name);
-  if(elem != methods.end()){
+  return findMethod(SymbolTable::intern(name));
+}
+
+/**
+ * @brief Searches and returns the runtime representation of a method, given the interned ID of its name. If
+ * such runtime representation is not found, this method returns a nullptr.
+ * 
+ * This method is responsible for looking up a method in the flattened method table of the class. Since such 
+ * table already contains the inherited methods, there is no need to walk the chain of superclasses.
+ * 
+ * @param nameId: The interned ID of the name of the required method.
+ * 
+ * @return The runtime representation of the required method or a nullptr, if the class does not have (or 
+ * inherit) a method with such name.
+**/
+std::shared_ptr<BleachFunction> BleachClass::findMethod(int nameId){
+  auto elem = methodTable.find(nameId);
+  if(elem != methodTable.end()){
     return elem->second;
   }
 
-  // If the method is not found, then, maybe it's inside of some superclass of the current class.
-  if(superclass != nullptr){
-    return superclass->findMethod(name);
+  return nullptr;
+}
+
+/**
+ * @brief Returns the slot that a field occupies inside the instances of the class, given the interned ID of its
+ * name. If such field is not part of the layout of the class, this method returns -1.
+ * 
+ * @param nameId: The interned ID of the name of the field.
+ * 
+ * @return The index of the slot of the field or -1, if the field is not part of the layout of the class.
+**/
+int BleachClass::findFieldSlot(int nameId){
+  auto elem = fieldSlots.find(nameId);
+  if(elem != fieldSlots.end()){
+    return elem->second;
   }
 
-  return nullptr;
+  return -1;
 }
 
 /**
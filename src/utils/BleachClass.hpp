@@ -4,6 +4,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "./BleachCallable.hpp"
@@ -12,6 +13,19 @@
 class Interpreter; // Forward declaration necessary to implement the BleachClass class.
 class BleachFunction; // Forward declaration necessary to implement the BleachClass class.
 
+/**
+ * @struct FieldInitializer
+ * 
+ * @brief Describes one assignment performed by a simple "init" method: The slot of the field that is assigned
+ * and the index of the parameter whose argument is assigned to it. If such index is -1, then the value assigned
+ * to the field is the "literal" attribute.
+**/
+struct FieldInitializer{
+  int slot;
+  int parameter;
+  std::any literal;
+};
+
 /**
  * @class BleachClass
  * 
@@ -25,20 +39,47 @@ class BleachFunction; // Forward declaration necessary to implement the BleachCl
  * the case, then the value of "superclass" will be nullptr. The third one is "methods". It is a map that stores
  * key-value pairs. In this map, a key is the name of a method (a string) and its associated value is a runtime 
  * representation of the method that was declared inside the class.
+ * When a class is created, it is also finalized: The "methodTable" attribute is filled with every method that 
+ * can be called on its instances, including the inherited ones (which are copied down from the method table of
+ * the superclass). Such table is keyed by the interned ID of the method name. The "initializer" attribute 
+ * caches the "init" method (declared or inherited), if any. Therefore, the cost of looking up a method does not
+ * depend on the depth of the chain of superclasses.
+ * Finally, the class also computes the layout of its instances: The "fieldSlots" attribute maps the interned ID
+ * of every field that is assigned to "self" inside the "init" method of the class (or of any of its 
+ * superclasses) to a slot. Every instance of the class is created with "fieldCount" slots, so the fields that 
+ * are predicted by the layout do not need to be inserted one at a time.
+ * If the "init" method of the class is simple (its body only assigns parameters or literals to fields of 
+ * "self"), the "simpleInitializer" attribute holds, for each of such assignments, the slot of the field and 
+ * where its value comes from. In this case, instances are built directly from the arguments of the call, 
+ * without executing the "init" method (and without creating any environment for it). The instance itself is 
+ * still allocated: No escape analysis is performed, since the fields of an instance that does not escape would 
+ * have to be kept inside an environment, which costs as much as the instance.
 **/
 class BleachClass : public BleachCallable, public std::enable_shared_from_this<BleachClass>{
   private:
     friend class BleachInstance; // Instances of the "BleachInstance" class can access the private attributes of this class.
+    friend class SnapshotReader; // Snapshots store and rebuild the methods and the layout of classes.
+    friend class SnapshotWriter;
 
     const std::string name;
     const std::shared_ptr<BleachClass> superclass;
     std::map<std::string, std::shared_ptr<BleachFunction>> methods;
+    std::unordered_map<int, std::shared_ptr<BleachFunction>> methodTable; // Flattened table: declared and inherited methods, keyed by the interned ID of their names.
+    std::shared_ptr<BleachFunction> initializer; // The "init" method of the class (declared or inherited), if any.
+    std::unordered_map<int, int> fieldSlots; // Layout of the instances: maps the interned ID of a field to its slot.
+    int fieldCount = 0; // Amount of slots of each instance of the class.
+    bool hasSimpleInitializer = false; // Whether the "init" method of the class can be replaced by the assignments below.
+    std::vector<FieldInitializer> simpleInitializer; // The assignments performed by a simple "init" method.
+
+    void analyzeInitializer();
 
   public:
-    BleachClass(std::string name, std::shared_ptr<BleachClass> superclass, std::map<std::string, std::shared_ptr<BleachFunction>> methods);
+    BleachClass(std::string name, std::shared_ptr<BleachClass> superclass, std::map<std::string, std::shared_ptr<BleachFunction>> methods, const std::vector<int>& fieldIds);
     int arity() override;
-    std::any call(Interpreter& interpreter, std::vector<std::any> arguments) override;
-    std::any call(Interpreter& interpreter, Token paren, std::vector<std::any> arguments) override;
+    std::any call(Interpreter& interpreter, ArgumentSpan arguments) override;
+    std::any call(Interpreter& interpreter, const Token& paren, ArgumentSpan arguments) override;
     std::shared_ptr<BleachFunction> findMethod(const std::string& name);
+    std::shared_ptr<BleachFunction> findMethod(int nameId);
+    int findFieldSlot(int nameId);
     std::string toString() override;
 };
@@ -4,6 +4,7 @@
 #include "./Environment.hpp"
 #include "../interpreter/Interpreter.hpp"
 #include "./Stmt.hpp"
+#include "./Streams.hpp"
 
 
 /**
@@ -78,24 +79,74 @@ std::shared_ptr<BleachFunction> BleachFunction::bind(std::shared_ptr<BleachInsta
  
  * @return The corresponding value that the user-defined function or method is supposed to return.
 **/
-std::any BleachFunction::call(Interpreter& interpreter, std::vector<std::any> arguments){
-  auto environment = std::make_shared<Environment>(closure); // Create an environment (scope) for the function that is about to be executed. The function environment has as its parent environment the closure that involves it.
+std::any BleachFunction::call(Interpreter& interpreter, ArgumentSpan arguments){
+  return invoke(interpreter, closure, arguments);
+}
+
+/**
+ * @brief Executes the instance of the BleachFunction class as a method of the received instance, without
+ * creating a bound copy of it.
+ * 
+ * This method is responsible for calling a method directly on an instance of the BleachInstance class. It 
+ * creates the environment that binds the name "self" to the received instance (exactly like the "bind" method 
+ * does), but it skips the creation of a new BleachFunction object. It's used by the interpreter to perform 
+ * calls through the "super" keyword, whose target method is already known once the class is finalized.
+ * 
+ * @param interpreter: The reference to the instance of the Interpreter class that is running the Bleach file.
+ * @param self: A pointer to the instance of the BleachInstance class on which the method is being called.
+ * @param arguments: The list of arguments that are expected to be received by the method during runtime.
+ * 
+ * @return The corresponding value that the method is supposed to return.
+**/
+std::any BleachFunction::call(Interpreter& interpreter, std::shared_ptr<BleachInstance> self, ArgumentSpan arguments){
+  auto environment = std::make_shared<Environment>(closure);
+  environment->define("self", std::move(self));
+
+  return invoke(interpreter, environment, arguments);
+}
+
+/**
+ * @brief Executes the body of the function, whose parameters live in an environment enclosed by the received
+ * one. This is the common part between the two "call" methods above.
+ * 
+ * @param interpreter: The reference to the instance of the Interpreter class that is running the Bleach file.
+ * @param enclosing: The environment that encloses the environment of the parameters. If the function is an
+ * initializer, it's the environment where "self" is bound.
+ * @param arguments: The list of arguments that are expected to be received by the function.
+ * 
+ * @return The corresponding value that the function is supposed to return.
+**/
+std::any BleachFunction::invoke(Interpreter& interpreter, const std::shared_ptr<Environment>& enclosing, ArgumentSpan arguments){
+  if(!functionDeclaration->pure){ // The side effects of the function invalidate the common subexpressions computed by its caller.
+    interpreter.sideEffects++;
+  }
+  Interpreter::Activation activation{interpreter}; // The common subexpressions of the body belong to this call only.
+
+  auto environment = std::make_shared<Environment>(enclosing); // Create an environment (scope) for the function that is about to be executed. The function environment has as its parent environment the closure that involves it.
 
   for(int i = 0; i < functionDeclaration->parameters.size(); i++){ // Create the bindings between the parameters of the function and its corresponding arguments, that were passed during the function.
-    environment->define(functionDeclaration->parameters[i].lexeme, arguments[i]);
+    environment->define(functionDeclaration->parameters[i].lexeme, std::move(arguments[i])); // The arguments are owned by the value stack of the interpreter and thrown away after the call, so they are moved instead of copied.
+  }
+
+  if(functionDeclaration->tailReturn){ // The only return statement is the last one, so there's nothing to be caught.
+    std::any value = interpreter.executeTailReturnBlock(functionDeclaration->body, environment);
+    if(isInitializer){
+      return enclosing->getAt("self", 0);
+    }
+    return value;
   }
 
   try{
     interpreter.executeBlock(functionDeclaration->body, environment); // Execute the statements that are present inside the function. Pay attention to the fact that the current environment of the newly created function is passed as an argument to this method.
   }catch(BleachReturn returnValue){ // Caught a return value during the execution of the function. Then, it needs to return such value.
     if(isInitializer){
-      return closure->getAt("self", 0); // Earlier empty return ("return;") from a constructor of a class.
+      return enclosing->getAt("self", 0); // Earlier empty return ("return;") from a constructor of a class.
     }
     return returnValue.value;
   }
 
   if(isInitializer){ // If the function is a constructor ("init" method), then it will always (implicitly) return "self".
-    return closure->getAt("self", 0); // Remember that the binding between "self" and its corresponding instance is stored in the "closure" environment.
+    return enclosing->getAt("self", 0); // Remember that the binding between "self" and its corresponding instance is stored in the enclosing environment.
   }
 
   return nullptr; // This here is necessary for the case when a function does not have a "return" statement. By default, all user defined functions in Bleach return nil (C++ nullptr).
@@ -105,8 +156,8 @@ std::any BleachFunction::call(Interpreter& interpreter, std::vector<std::any> ar
  * @note: This overloaded version of the 'call' method is restricted to be used when calling Bleach native 
  * functions. It won't be called by an instance of a BleachFunction class.
 **/
-std::any BleachFunction::call(Interpreter& interpreter, Token paren, std::vector<std::any> arguments){
- std::cout << "No implementation of this method available for the 'BleachFunction' class." << std::endl;
+std::any BleachFunction::call(Interpreter& interpreter, const Token& paren, ArgumentSpan arguments){
+ *outputStream << "No implementation of this method available for the 'BleachFunction' class." << std::endl;
  
   return {};
 }
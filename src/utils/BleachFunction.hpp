@@ -29,15 +29,22 @@ class Function; // Forward declaration necessary to implement the BleachFunction
 **/
 class BleachFunction : public BleachCallable{
   private:
+    friend class BleachClass; // Instances of the "BleachClass" class can inspect the declaration of their "init" method.
+    friend class SnapshotReader; // Snapshots store and rebuild the declaration and the closure of functions.
+    friend class SnapshotWriter;
+
     bool isInitializer;
     std::shared_ptr<Environment> closure;
     std::shared_ptr<Function> functionDeclaration;
+
+    std::any invoke(Interpreter& interpreter, const std::shared_ptr<Environment>& enclosing, ArgumentSpan arguments);
     
   public:
     BleachFunction(std::shared_ptr<Function> functionDeclaration, std::shared_ptr<Environment> closure, bool isInitializer);
     int arity() override;
     std::shared_ptr<BleachFunction> bind(std::shared_ptr<BleachInstance> instance);
-    std::any call(Interpreter& interpreter, std::vector<std::any> arguments) override;
-    std::any call(Interpreter& interpreter, Token paren, std::vector<std::any> arguments) override;
+    std::any call(Interpreter& interpreter, ArgumentSpan arguments) override;
+    std::any call(Interpreter& interpreter, const Token& paren, ArgumentSpan arguments) override;
+    std::any call(Interpreter& interpreter, std::shared_ptr<BleachInstance> self, ArgumentSpan arguments);
     std::string toString() override;
 };
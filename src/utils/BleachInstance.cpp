@@ -1,6 +1,7 @@
 #include <utility>
 
 #include "./BleachInstance.hpp"
+#include "./SymbolTable.hpp"
 #include "../error/BleachRuntimeError.hpp"
 
 
@@ -11,9 +12,11 @@
  * "BleachInstance.hpp" file.
  *
  * @param klass: The name of the user-define class that has generated an instance of this BleachInstance class. 
+ *
+ * @note: The slots of the instance are allocated here, all at once, following the layout of its class.
 **/
 BleachInstance::BleachInstance(std::shared_ptr<BleachClass> klass)
-  : klass{std::move(klass)}
+  : klass{std::move(klass)}, slots(this->klass->fieldCount)
 {}
 
 std::string BleachInstance::formatDouble(double value){
@@ -41,6 +44,27 @@ std::string BleachInstance::formatDouble(double value){
   return out.str();
 }
 
+/**
+ * @brief Returns the method of the class of this instance whose name has the given interned ID, unless such 
+ * name is shadowed by a field of this instance. In that case (or if there's no such method), it returns a 
+ * nullptr.
+ * 
+ * @param nameId: The interned ID of the name of the method.
+ *
+ * @return The runtime representation of the method (not bound to this instance) or a nullptr.
+**/
+std::shared_ptr<BleachFunction> BleachInstance::findMethod(int nameId){
+  int slot = klass->findFieldSlot(nameId);
+  if(slot != -1 && slots[slot].has_value()){
+    return nullptr;
+  }
+  if(!fields.empty() && fields.find(nameId) != fields.end()){
+    return nullptr;
+  }
+
+  return klass->findMethod(nameId);
+}
+
 /**
  * @brief Tries to retrieve the value associated to a property whose name was given as an argument.
  * 
@@ -54,6 +78,7 @@ std::string BleachInstance::formatDouble(double value){
  * instance.
  * 
  * @param name: A token that represents the name of the property whose value is required.
+ * @param nameId: The interned ID of the name of the property. It is used to look up methods.
  *
  * @return The value associated to the name of the property. If such name is not found, then a runtime error is
  * thrown.
@@ -65,16 +90,21 @@ std::string BleachInstance::formatDouble(double value){
  * will never return the method of the class associated with the name "foo". Basically, this means that 
  * attributes/fields shadow methods.
 **/
-std::any BleachInstance::get(const Token& name){
+std::any BleachInstance::get(const Token& name, int nameId){
   // When some property of an instance is accessed, first we check if its a field/attribute.
-  auto elem = fields.find(name.lexeme);
+  int slot = klass->findFieldSlot(nameId);
+  if(slot != -1 && slots[slot].has_value()){
+    return slots[slot];
+  }
+
+  auto elem = fields.find(nameId);
   if(elem != fields.end()){
     return elem->second;
   }
 
   // If that's not the case, then we check whether it's a method from the class of the instance.
   // In short, fields/attributes shadow methods.
-  auto method = klass->findMethod(name.lexeme);
+  auto method = klass->findMethod(nameId);
   if(method != nullptr){
     return method->bind(shared_from_this());
   }
@@ -90,13 +120,20 @@ std::any BleachInstance::get(const Token& name){
  * Such method is only called when a "Set" expression is evaluated.
  * 
  * @param name: A token that represents the name of the attribute/field to which a value will be assigned to.
+ * @param nameId: The interned ID of the name of the attribute/field.
  * @param value: The value that will be assigned to the attribute/field of this instance of the BleachInstance
  * class.
  *
  * @return Nothing (void).
 **/
-void BleachInstance::set(const Token& name, std::any value){
-  fields[name.lexeme] = std::move(value);
+void BleachInstance::set(const Token& name, int nameId, std::any value){
+  int slot = klass->findFieldSlot(nameId);
+  if(slot != -1){
+    slots[slot] = std::move(value);
+    return;
+  }
+
+  fields[nameId] = std::move(value);
 
   return;
 }
@@ -110,12 +147,14 @@ void BleachInstance::set(const Token& name, std::any value){
  * @return A string that is the string representation of this instance of the BleachInstance class.
 **/
 std::string BleachInstance::toString(Interpreter& interpreter){
-  std::shared_ptr<BleachFunction> instanceReprMethod = klass->findMethod("str");
+  static const int strId = SymbolTable::intern("str");
+
+  std::shared_ptr<BleachFunction> instanceReprMethod = klass->findMethod(strId);
   if(instanceReprMethod != nullptr){
-    if(instanceReprMethod->bind(shared_from_this())->call(interpreter, std::vector<std::any>{}).type() == typeid(std::string)){
-      return std::any_cast<std::string>(instanceReprMethod->bind(shared_from_this())->call(interpreter, std::vector<std::any>{}));
-    }else if(instanceReprMethod->bind(shared_from_this())->call(interpreter, std::vector<std::any>{}).type() == typeid(double)){
-      return formatDouble(std::any_cast<double>(instanceReprMethod->bind(shared_from_this())->call(interpreter, std::vector<std::any>{})));
+    if(instanceReprMethod->bind(shared_from_this())->call(interpreter, ArgumentSpan{}).type() == typeid(std::string)){
+      return std::any_cast<std::string>(instanceReprMethod->bind(shared_from_this())->call(interpreter, ArgumentSpan{}));
+    }else if(instanceReprMethod->bind(shared_from_this())->call(interpreter, ArgumentSpan{}).type() == typeid(double)){
+      return formatDouble(std::any_cast<double>(instanceReprMethod->bind(shared_from_this())->call(interpreter, ArgumentSpan{})));
     }
   }
   
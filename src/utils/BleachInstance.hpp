@@ -4,6 +4,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 
@@ -24,15 +25,26 @@ class Token; // Forward declaration necessary to implement the BleachInstance cl
  * what class an instance belongs to. The second one is "fields". It is a map that stores key-value pairs where
  * the key is a string representing the name of an attribute/field stored inside that instance of the 
  * BleachInstance class and its corresponding value is the value of the attribute/field. 
+ * The fields are actually stored in two places: The "slots" attribute is a vector that is allocated, with its
+ * final size, when the instance is created. It holds the fields predicted by the layout of the class (the ones
+ * assigned to "self" inside the "init" method). An empty slot means that such field has not been assigned yet.
+ * The "fields" attribute is a map, keyed by the interned ID of the name of a field, that holds any other field
+ * that is assigned to the instance later on.
 **/
 class BleachInstance : public std::enable_shared_from_this<BleachInstance>{
   private:
+    friend class BleachClass; // Instances of the "BleachClass" class can fill the slots of the instances they create.
+    friend class SnapshotReader; // Snapshots store and rebuild the fields of instances.
+    friend class SnapshotWriter;
+
     std::shared_ptr<BleachClass> klass;
-    std::map<std::string, std::any> fields; // Do not forget that this is a runtime representation of an instance/object. That's why we use the "std::any" type here.
+    std::vector<std::any> slots; // Fields predicted by the layout of the class. Do not forget that this is a runtime representation of an instance/object. That's why we use the "std::any" type here.
+    std::unordered_map<int, std::any> fields; // Fields that are not part of the layout of the class.
   public:
     BleachInstance(std::shared_ptr<BleachClass> klass);
     std::string formatDouble(double value);
-    std::any get(const Token& name);
-    void set(const Token& name, std::any value);
+    std::shared_ptr<BleachFunction> findMethod(int nameId);
+    std::any get(const Token& name, int nameId);
+    void set(const Token& name, int nameId, std::any value);
     std::string toString(Interpreter& interpreter);
 };
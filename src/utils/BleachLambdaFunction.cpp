@@ -4,6 +4,7 @@
 #include "./Environment.hpp"
 #include "../interpreter/Interpreter.hpp"
 #include "./Stmt.hpp"
+#include "./Streams.hpp"
 
 
 /**
@@ -54,11 +55,16 @@ int BleachLambdaFunction::arity(){
  * the BleachLambdaFunction object (triggered by calling this method) will return a nullptr value (nil value in 
  * Bleach).
 **/
-std::any BleachLambdaFunction::call(Interpreter& interpreter, std::vector<std::any> arguments){
+std::any BleachLambdaFunction::call(Interpreter& interpreter, ArgumentSpan arguments){
+  if(!lambdaFunctionDeclaration->pure){ // The side effects of the lambda function invalidate the common subexpressions computed by its caller.
+    interpreter.sideEffects++;
+  }
+  Interpreter::Activation activation{interpreter}; // The common subexpressions of the body belong to this call only.
+
   auto environment = std::make_shared<Environment>(closure); // Create an environment (scope) for the function that is about to be executed. The function environment has as its parent environment the closure that involves it.
 
   for(int i = 0; i < lambdaFunctionDeclaration->parameters.size(); i++){ // Create the bindings between the parameters of the function and its corresponding arguments, that were passed during the function.
-    environment->define(lambdaFunctionDeclaration->parameters[i].lexeme, arguments[i]);
+    environment->define(lambdaFunctionDeclaration->parameters[i].lexeme, std::move(arguments[i])); // The arguments are owned by the value stack of the interpreter, so they are moved instead of copied.
   }
 
   try{
@@ -74,8 +80,8 @@ std::any BleachLambdaFunction::call(Interpreter& interpreter, std::vector<std::a
  * @note: This overloaded version of the 'call' method is restricted to be used when calling Bleach native 
  * functions. It won't be called by an instance of a BleachLambdaFunction class.
 **/
-std::any BleachLambdaFunction::call(Interpreter& interpreter, Token paren, std::vector<std::any> arguments){
-  std::cout << "No implementation of this method available for the 'BleachLambdaFunction' class." << std::endl;
+std::any BleachLambdaFunction::call(Interpreter& interpreter, const Token& paren, ArgumentSpan arguments){
+  *outputStream << "No implementation of this method available for the 'BleachLambdaFunction' class." << std::endl;
  
   return {};
 }
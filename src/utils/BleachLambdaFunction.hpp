@@ -24,12 +24,15 @@ class LambdaFunction; // Forward declaration necessary to implement the BleachLa
 **/
 class BleachLambdaFunction : public BleachCallable{
   private:
+    friend class SnapshotReader; // Snapshots store and rebuild the declaration and the closure of lambda functions.
+    friend class SnapshotWriter;
+
     std::shared_ptr<Environment> closure;
     std::shared_ptr<LambdaFunction> lambdaFunctionDeclaration;
   public:
     BleachLambdaFunction(std::shared_ptr<LambdaFunction> lambdaFunctionDeclaration, std::shared_ptr<Environment> closure);
     int arity() override;
-    std::any call(Interpreter& interpreter, std::vector<std::any> arguments) override;
-    std::any call(Interpreter& interpreter, Token paren, std::vector<std::any> arguments) override;
+    std::any call(Interpreter& interpreter, ArgumentSpan arguments) override;
+    std::any call(Interpreter& interpreter, const Token& paren, ArgumentSpan arguments) override;
     std::string toString() override;
 };
@@ -5,7 +5,9 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "../error/Error.hpp"
 #include "./Token.hpp"
@@ -25,13 +27,29 @@
  * inside the same scope, the tokens that represent the same identifier must point to the same value. To do
  * that, we use the "lexeme" attribute of the "Token" class. By doing so, we make sure that different tokens
  * with the same lexeme point to the same value, if, and only if, such tokens are in the same scope.
+ * The global environment (the only one with no enclosing environment) is the exception: It stores its bindings
+ * inside the "slots" attribute, a vector indexed by a slot number that is assigned to each global name (by the
+ * Resolver, or when the name is first defined) and never changes. An empty slot means that the global variable
+ * has not been defined yet.
 **/
 class Environment : public std::enable_shared_from_this<Environment>{
   private:
     friend class Interpreter;
+    friend class SnapshotReader;
+    friend class SnapshotWriter;
 
     std::map<std::string,std::any> values; /**< Variable that stores the bindings between variables' names and their associated values. */
     std::shared_ptr<Environment> enclosing; /**< Variable that points to its enclosing environment (the "parent" environment of this environment). */
+    std::vector<std::any> slots; /**< Variable that stores the values of the global variables, indexed by their slots. Only used by the global environment. */
+    std::unordered_map<std::string, int> slotIndices; /**< Variable that maps the name of each global variable to its slot. Only used by the global environment. */
+
+    void undefinedVariable(const Token& name){
+      if(name.lexeme == "]"){
+        throw BleachRuntimeError{name, "Values of 'str' type do not suport nesting indexing."};
+      }
+
+      throw BleachRuntimeError{name, "Undefined variable '" + name.lexeme + "'."};
+    }
 
   public:
     /**
@@ -106,6 +124,15 @@ class Environment : public std::enable_shared_from_this<Environment>{
      * BleachRuntimeError class is thrown by the method.
      */
     void assign(const Token& name, std::any value){
+      if(enclosing == nullptr){ // The global environment stores its variables inside slots.
+        auto slot = slotIndices.find(name.lexeme);
+        if(slot != slotIndices.end() && slots[slot->second].has_value()){
+          slots[slot->second] = std::move(value);
+          return;
+        }
+        throw BleachRuntimeError{name, "Undefined variable '" + name.lexeme + "'."};
+      }
+
       auto elem = values.find(name.lexeme);
 
       if(elem != values.end()){
@@ -210,6 +237,11 @@ class Environment : public std::enable_shared_from_this<Environment>{
      * to perform variable redefinition, but only inside the global scope.
      */
     void define(const std::string& name, std::any value){
+      if(enclosing == nullptr){ // The global environment stores its variables inside slots.
+        slots[slotOf(name)] = std::move(value);
+        return;
+      }
+
       values[name] = std::move(value);
 
       return;
@@ -235,21 +267,127 @@ class Environment : public std::enable_shared_from_this<Environment>{
      * such variable was not declared. Therefore, a runtime error is thrown.
      */
     std::any get(const Token& name){
+      if(enclosing == nullptr){ // The global environment stores its variables inside slots.
+        auto slot = slotIndices.find(name.lexeme);
+        if(slot != slotIndices.end()){
+          return getSlot(slot->second, name);
+        }
+        undefinedVariable(name);
+      }
+
       auto elem = values.find(name.lexeme);
 
       if(elem != values.end()){
         return values[name.lexeme];
       }
-      
-      if(enclosing != nullptr){
-        return enclosing->get(name);
+
+      return enclosing->get(name);
+    }
+
+    /**
+     * @brief Returns the slot of a global variable, given its name. If such name has never been seen before, a
+     * new (empty) slot is created for it.
+     *
+     * This method must only be called on the global environment. It's used by the Resolver to bind every 
+     * reference to a global variable to the slot of such variable, and by the "define" method above.
+     * 
+     * @param name: The name of the global variable.
+     * 
+     * @return The index of the slot of the global variable.
+     */
+    int slotOf(const std::string& name){
+      auto elem = slotIndices.find(name);
+      if(elem != slotIndices.end()){
+        return elem->second;
       }
 
-      if(name.lexeme == "]"){
-        throw BleachRuntimeError{name, "Values of 'str' type do not suport nesting indexing."};
+      int slot = slots.size();
+      slotIndices.emplace(name, slot);
+      slots.emplace_back(); // An empty slot: The variable has not been defined yet.
+
+      return slot;
+    }
+
+    /**
+     * @brief Returns the amount of global variables that are currently defined. It must only be called on the
+     * global environment.
+     *
+     * @return The amount of non-empty slots.
+     */
+    std::size_t definedSlots(){
+      std::size_t count = 0;
+      for(const std::any& slot : slots){
+        if(slot.has_value()){
+          count++;
+        }
       }
 
-      throw BleachRuntimeError{name, "Undefined variable '" + name.lexeme + "'."};
+      return count;
+    }
+
+    /**
+     * @brief Returns the amount of slots of the global environment (defined or not). It must only be called on
+     * the global environment.
+     *
+     * @return The amount of slots.
+     */
+    std::size_t slotCount(){
+      return slots.size();
+    }
+
+    /**
+     * @brief Returns the names of the global variables, ordered by their slots. It must only be called on the
+     * global environment.
+     *
+     * Calling "slotOf" with these names, in this order, on a fresh global environment reproduces the same
+     * layout. That's how an AST resolved against one instance of the Interpreter class can be run by another.
+     *
+     * @return The names of the global variables, where the i-th name is the one bound to the i-th slot.
+     */
+    std::vector<std::string> slotNames(){
+      std::vector<std::string> names(slots.size());
+      for(const auto& [name, slot] : slotIndices){
+        names[slot] = name;
+      }
+
+      return names;
+    }
+
+    /**
+     * @brief Returns the value of the global variable stored in the given slot. If such variable has not been
+     * defined yet, then an instance of the BleachRuntimeError class is thrown.
+     *
+     * @param slot: The index of the slot of the global variable.
+     * @param name: The token that represents the name of the global variable. Used for error reporting.
+     * 
+     * @return The value of the global variable.
+     */
+    std::any getSlot(int slot, const Token& name){
+      if(!slots[slot].has_value()){
+        undefinedVariable(name);
+      }
+
+      return slots[slot];
+    }
+
+    /**
+     * @brief Assigns a value to the global variable stored in the given slot. If such variable has not been
+     * defined yet, then an instance of the BleachRuntimeError class is thrown.
+     *
+     * @param slot: The index of the slot of the global variable.
+     * @param name: The token that represents the name of the global variable. Used for error reporting.
+     * @param value: The value that will be assigned to the global variable.
+     * 
+     * @return Nothing (void).
+     */
+    void assignSlot(int slot, const Token& name, std::any value){
+      if(!slots[slot].has_value()){
+        undefinedVariable(name);
+      }
+
+      slots[slot] = std::move(value);
+
+      return;
     }
 
     /**
@@ -1,16 +1,19 @@
 #pragma once
 
 #include <any>
+#include <atomic>
 #include <memory>
 #include <utility>
 #include <vector>
 
+#include "./SymbolTable.hpp"
 #include "./Token.hpp"
 
 
 // Necessary forward declarations of certain structs so they can be used inside the 'ExprVisitor' struct below.
 struct Assign;
 struct Binary;
+struct Cached;
 struct Call;
 struct Get;
 struct Grouping;
@@ -26,6 +29,36 @@ struct Unary;
 struct Variable;
 
 struct Stmt; // Forward declaration needed to avoid circular dependencies.
+class BleachClass; // Forward declaration needed by the cache of the "Super" struct.
+class BleachFunction; // Forward declaration needed by the cache of the "Super" struct.
+
+/**
+ * @enum ExprKind
+ * 
+ * @brief Tags each kind of expression node from the Bleach AST (Abstract Syntax Tree).
+ *
+ * Every expression node stores its own kind, so the Interpreter class can jump straight to the visit method of
+ * a node without going through the virtual "accept" method. The order of the enumerators must match the order
+ * of the dispatch table inside the "evaluate" method of the Interpreter class.
+ */
+enum class ExprKind{
+  ASSIGN,
+  BINARY,
+  CACHED,
+  CALL,
+  GET,
+  GROUPING,
+  LAMBDAFUNCTION,
+  LISTLITERAL,
+  LITERAL,
+  LOGICAL,
+  SELF,
+  SET,
+  SUPER,
+  TERNARY,
+  UNARY,
+  VARIABLE,
+};
 
 /**
  * @struct ExprVisitor
@@ -44,6 +77,7 @@ struct Stmt; // Forward declaration needed to avoid circular dependencies.
 struct ExprVisitor{
   virtual std::any visitAssignExpr(std::shared_ptr<Assign> expr) = 0;
   virtual std::any visitBinaryExpr(std::shared_ptr<Binary> expr) = 0;
+  virtual std::any visitCachedExpr(std::shared_ptr<Cached> expr) = 0;
   virtual std::any visitCallExpr(std::shared_ptr<Call> expr) = 0;
   virtual std::any visitGetExpr(std::shared_ptr<Get> expr) = 0;
   virtual std::any visitGroupingExpr(std::shared_ptr<Grouping> expr) = 0;
@@ -69,9 +103,28 @@ struct ExprVisitor{
  * The Expr struct defines an abstract struct that is responsible for working as the base struct from which all
  * structs that represent different types of expression AST nodes will derive from. This struct has only a pure
  * virtual method called 'accept'. This method will be overridden by the derived structs where each kind of 
- * struct will have its own implementation for such method.
+ * struct will have its own implementation for such method. It also has an attribute called "kind", which tells
+ * which derived struct the node actually is.
+ * Finally, the "liveNodes" static attribute counts how many expression nodes are currently alive. It's reported
+ * by the ":mem" command of the REPL.
+ * The children of the nodes are not constant, since the Optimizer class replaces the common subexpressions of a
+ * list of statements with Cached nodes once such list has been resolved.
  */
 struct Expr{
+  static inline std::atomic<long> liveNodes{0};
+
+  const ExprKind kind;
+
+  Expr(ExprKind kind)
+    : kind{kind}
+  {
+    liveNodes++;
+  }
+
+  virtual ~Expr(){
+    liveNodes--;
+  }
+
   virtual std::any accept(ExprVisitor& visitor) = 0;
 };
 
@@ -89,10 +142,16 @@ struct Expr{
  * find out to which variable declaration that token (identifier) is referring to. Then, it evaluates the 
  * right-hand side operand to produce a value. Finally, it assigns such produced value to the referred variable
  * and also returns the produced value, since an assignment in Bleach is an expression.
+ * The Resolver stores where the assigned variable lives: If it is a local variable, the "depth" attribute holds
+ * the amount of hops between the current environment and the environment of the variable. Otherwise, "depth"
+ * is -1 and the "globalSlot" attribute holds the slot of the variable inside the global environment.
  */
 struct Assign : Expr, public std::enable_shared_from_this<Assign>{
   const Token name;
-  const std::shared_ptr<Expr> value;
+  std::shared_ptr<Expr> value;
+  int depth = -1; // Distance (in environments) to the variable, if it is a local variable. Set by the Resolver.
+  int globalSlot = -1; // Slot of the variable inside the global environment, if it is a global variable. Set by the Resolver.
+  bool accumulates = false; // Whether the assignment has the form "name = name + value", so a list held only by the variable can be extended in place. Set by the Resolver.
 
   /**
    * @brief Constructs an Assign node of the Bleach AST (Abstract Syntax Tree). 
@@ -105,7 +164,7 @@ struct Assign : Expr, public std::enable_shared_from_this<Assign>{
    * @param value: The right-hand side operand of the assignment operation. Also known as "r-value".
   **/
   Assign(Token name, std::shared_ptr<Expr> value)
-    : name{std::move(name)}, value{std::move(value)}
+    : Expr{ExprKind::ASSIGN}, name{std::move(name)}, value{std::move(value)}
   {}
 
   std::any accept(ExprVisitor& visitor) override{
@@ -124,9 +183,9 @@ struct Assign : Expr, public std::enable_shared_from_this<Assign>{
  * will be performed on these two operands ("op").
  */
 struct Binary : Expr, public std::enable_shared_from_this<Binary>{
-  const std::shared_ptr<Expr> left;
+  std::shared_ptr<Expr> left;
   const Token op;
-  const std::shared_ptr<Expr> right;
+  std::shared_ptr<Expr> right;
 
   /**
    * @brief Constructs a Binary node of the Bleach AST (Abstract Syntax Tree). 
@@ -139,7 +198,7 @@ struct Binary : Expr, public std::enable_shared_from_this<Binary>{
    * @param right: The right operand of the binary operator.
   **/
   Binary(std::shared_ptr<Expr> left, Token op, std::shared_ptr<Expr> right)
-    : left{std::move(left)}, op{std::move(op)}, right{std::move(right)} 
+    : Expr{ExprKind::BINARY}, left{std::move(left)}, op{std::move(op)}, right{std::move(right)} 
   {}
 
   std::any accept(ExprVisitor& visitor) override{
@@ -147,6 +206,59 @@ struct Binary : Expr, public std::enable_shared_from_this<Binary>{
   }
 };
 
+/**
+ * @struct CachedValue
+ *
+ * @brief The value shared by the Cached nodes that replace the occurrences of the same subexpression.
+ *
+ * The value is only valid inside the call of the function (or lambda function) that has stored it ("activation")
+ * and while no side effect has happened since its evaluation started ("epoch"). See the "sideEffects" and the
+ * "activation" attributes of the Interpreter class.
+ */
+struct CachedValue{
+  std::any value;
+  unsigned long epoch = 0;
+  unsigned long activation = 0;
+  bool valid = false;
+};
+
+/**
+ * @struct Cached
+ *
+ * @brief Defines a struct to represent an occurrence of a common subexpression of a list of statements.
+ *
+ * The Cached struct is never produced by the Parser class. The Optimizer class wraps every occurrence of a
+ * subexpression that shows up more than once in the same list of statements (e.g. "self.heap.getAt(i)") into a
+ * Cached node, as long as no variable it reads is assigned between such occurrences. The first occurrence
+ * evaluates the subexpression and stores its value inside the CachedValue that every occurrence shares ("store"),
+ * and the next ones reuse such value while it's still valid (see the CachedValue struct). Otherwise, they just
+ * evaluate the subexpression again.
+ * Only values that are copied when read (nil, booleans, numbers and strings) are stored. Lists, instances and
+ * other values that are shared by reference are only stored when they are read from a field ("referenceSafe"),
+ * since reusing them cannot hand out an object that the original subexpression would have created anew.
+ */
+struct Cached : Expr, public std::enable_shared_from_this<Cached>{
+  std::shared_ptr<Expr> expression;
+  const std::shared_ptr<CachedValue> cell;
+  const bool store; // Whether this is the first occurrence of the subexpression, which always evaluates it.
+  const bool referenceSafe; // Whether the subexpression is a Get expression.
+
+  /**
+   * @brief Constructs a Cached node of the Bleach AST (Abstract Syntax Tree).
+   *
+   * @param expression: The occurrence of the common subexpression.
+   * @param cell: The value shared by every occurrence of the common subexpression.
+   * @param store: Whether this is the first occurrence of the common subexpression.
+  **/
+  Cached(std::shared_ptr<Expr> expression, std::shared_ptr<CachedValue> cell, bool store)
+    : Expr{ExprKind::CACHED}, expression{std::move(expression)}, cell{std::move(cell)}, store{store}, referenceSafe{this->expression->kind == ExprKind::GET}
+  {}
+
+  std::any accept(ExprVisitor& visitor) override{
+    return visitor.visitCachedExpr(shared_from_this());
+  }
+};
+
 /**
  * @struct Call
  * 
@@ -162,9 +274,10 @@ struct Binary : Expr, public std::enable_shared_from_this<Binary>{
  * runtime.
  */
 struct Call : Expr, public std::enable_shared_from_this<Call>{
-  const std::shared_ptr<Expr> callee;
+  std::shared_ptr<Expr> callee;
   const Token paren; // Token that represents the closing parentheses ')'. It is used to report a runtime error caused by a function call, if it happens.
-  const std::vector<std::shared_ptr<Expr>> arguments;
+  std::vector<std::shared_ptr<Expr>> arguments;
+  bool indexedAccess = false; // Whether the call is "object.getAt(i)", where "i" is the induction variable of a loop that is known to hold a non-negative integer. Set by the Optimizer.
 
   /**
    * @brief Constructs a Call node of the Bleach AST (Abstract Syntax Tree). 
@@ -180,7 +293,7 @@ struct Call : Expr, public std::enable_shared_from_this<Call>{
    * runtime so the call expression can also be properly evaluated during runtime.
   **/
   Call(std::shared_ptr<Expr> callee, Token paren, std::vector<std::shared_ptr<Expr>> arguments)
-    : callee{std::move(callee)}, paren{std::move(paren)}, arguments{std::move(arguments)}
+    : Expr{ExprKind::CALL}, callee{std::move(callee)}, paren{std::move(paren)}, arguments{std::move(arguments)}
   {}
 
   std::any accept(ExprVisitor& visitor) override{
@@ -198,7 +311,7 @@ struct Call : Expr, public std::enable_shared_from_this<Call>{
  * from an instance of a class. This struct has only two attributes: The first one is called "object". It is an
  * expression that, at runtime, must be evaluated into an instance of a user-defined class. The second one is
  * called "name". It is a token whose lexeme represents the name of the property that is attempting to be 
- * retrieved and returned. 
+ * retrieved and returned. It also stores "nameId", which is the interned ID of such name.
  */
 struct Get : Expr, public std::enable_shared_from_this<Get>{
   // This struct here represents a "Get" expression: someObject.someProperty
@@ -206,8 +319,9 @@ struct Get : Expr, public std::enable_shared_from_this<Get>{
   // name -> someProperty
   // At runtime, it will use a token of type IDENTIFIER to read the property with that name from the object
   // that the expression evaluates to.
-  const std::shared_ptr<Expr> object;
+  std::shared_ptr<Expr> object;
   const Token name;
+  const int nameId;
 
   /**
    * @brief Constructs a Get node of the Bleach AST (Abstract Syntax Tree). 
@@ -220,7 +334,7 @@ struct Get : Expr, public std::enable_shared_from_this<Get>{
    * retrieved and returned.
   **/
   Get(std::shared_ptr<Expr> object, Token name)
-    : object{std::move(object)}, name{std::move(name)}
+    : Expr{ExprKind::GET}, object{std::move(object)}, name{std::move(name)}, nameId{SymbolTable::intern(this->name.lexeme)}
   {}
 
   std::any accept(ExprVisitor& visitor) override{
@@ -238,7 +352,7 @@ struct Get : Expr, public std::enable_shared_from_this<Get>{
  * This struct has only one attribute called "expression" that represents the expression inside the parentheses.
  */
 struct Grouping : Expr, public std::enable_shared_from_this<Grouping>{
-  const std::shared_ptr<Expr> expression;
+  std::shared_ptr<Expr> expression;
 
   /**
    * @brief Constructs a Grouping node of the Bleach AST (Abstract Syntax Tree). 
@@ -249,7 +363,7 @@ struct Grouping : Expr, public std::enable_shared_from_this<Grouping>{
    * @param expression: The expression that is presented inside the parentheses of a grouping node.
   **/
   Grouping(std::shared_ptr<Expr> expression)
-    : expression{std::move(expression)}
+    : Expr{ExprKind::GROUPING}, expression{std::move(expression)}
   {}
 
   std::any accept(ExprVisitor& visitor) override{
@@ -271,10 +385,14 @@ struct Grouping : Expr, public std::enable_shared_from_this<Grouping>{
  * represents the list of parameters of the lambda (anonymous) function. The second one is called "body". It is
  * a list of statements. Such list contains every statement, in order, that will be executed by the lambda 
  * function during runtime.
+ * It also has a "declarationId" attribute, set by the Resolver, that numbers the lambda function among every 
+ * function and lambda function resolved by the same instance of the Interpreter class.
  */
 struct LambdaFunction : Expr, public std::enable_shared_from_this<LambdaFunction>{
   const std::vector<Token> parameters;
   const std::vector<std::shared_ptr<Stmt>> body;
+  int declarationId = -1; // The number of the declaration (see the "registerDeclaration" method of the Interpreter class). Set by the Resolver.
+  bool pure = false; // Whether the body of the lambda function has no side effects of its own. Set by the Resolver (see its "visitLambdaFunctionExpr" method).
 
   /**
    * @brief Constructs a LambdaFunction node of the Bleach AST (Abstract Syntax Tree). 
@@ -288,7 +406,7 @@ struct LambdaFunction : Expr, public std::enable_shared_from_this<LambdaFunction
    * representation of this lambda (anonymous) function is called.
   **/
   LambdaFunction(std::vector<Token> parameters, std::vector<std::shared_ptr<Stmt>> body)
-    : parameters{std::move(parameters)}, body{std::move(body)}
+    : Expr{ExprKind::LAMBDAFUNCTION}, parameters{std::move(parameters)}, body{std::move(body)}
   {}
 
   std::any accept(ExprVisitor& visitor) override{
@@ -300,7 +418,7 @@ struct ListLiteral : Expr, std::enable_shared_from_this<ListLiteral>{
   std::vector<std::shared_ptr<Expr>> elements;
 
   ListLiteral(std::vector<std::shared_ptr<Expr>> elements)
-    : elements{std::move(elements)}
+    : Expr{ExprKind::LISTLITERAL}, elements{std::move(elements)}
   {}
 
   std::any accept(ExprVisitor& visitor) override{
@@ -328,7 +446,7 @@ struct Literal : Expr, public std::enable_shared_from_this<Literal>{
    * @param value: The value that was generated by the literal.
   **/
   Literal(std::any value)
-    : value{std::move(value)}
+    : Expr{ExprKind::LITERAL}, value{std::move(value)}
   {}
 
   std::any accept(ExprVisitor& visitor) override{
@@ -353,9 +471,9 @@ struct Literal : Expr, public std::enable_shared_from_this<Literal>{
  * It's also important to mention that the "and" operator has a higher precedence compared to the "or" operator.
  */
 struct Logical : Expr, public std::enable_shared_from_this<Logical>{
-  const std::shared_ptr<Expr> left;
+  std::shared_ptr<Expr> left;
   const Token op;
-  const std::shared_ptr<Expr> right;
+  std::shared_ptr<Expr> right;
 
   /**
    * @brief Constructs a Logical node of the Bleach AST (Abstract Syntax Tree). 
@@ -368,7 +486,7 @@ struct Logical : Expr, public std::enable_shared_from_this<Logical>{
    * @param right: The right operand of the logical operator.
   **/
   Logical(std::shared_ptr<Expr> left, Token op, std::shared_ptr<Expr> right)
-    : left{std::move(left)}, op{std::move(op)}, right{std::move(right)} 
+    : Expr{ExprKind::LOGICAL}, left{std::move(left)}, op{std::move(op)}, right{std::move(right)} 
   {}
 
   std::any accept(ExprVisitor& visitor) override{
@@ -386,10 +504,12 @@ struct Logical : Expr, public std::enable_shared_from_this<Logical>{
  * very specific: the value is always the instance of a class. This expression is supposed to be used only in
  * the methods of a class declaration.
  * This struct has only one attribute called "keyword". This attribute is the token whose lexeme is the "self"
- * keyword. 
+ * keyword. It also has a "depth" attribute, set by the Resolver, which holds the amount of hops between the 
+ * current environment and the environment where "self" is bound.
  */
 struct Self : Expr, public std::enable_shared_from_this<Self>{
   const Token keyword;
+  int depth = -1; // Distance (in environments) to the binding of "self". Set by the Resolver.
 
   /**
    * @brief Constructs a Self node of the Bleach AST (Abstract Syntax Tree). 
@@ -399,7 +519,7 @@ struct Self : Expr, public std::enable_shared_from_this<Self>{
    * @param keyword: The token whose lexeme is the "self" keyword.
   **/
   Self(Token keyword)
-    : keyword{std::move(keyword)}
+    : Expr{ExprKind::SELF}, keyword{std::move(keyword)}
   {}
 
   std::any accept(ExprVisitor& visitor) override{
@@ -419,7 +539,8 @@ struct Self : Expr, public std::enable_shared_from_this<Self>{
  * The second one is called "name". It is a token whose lexeme represents the name of the field/attribute that 
  * will receive a value during runtime. The third attribute is called "value". It is an expression that will be
  * evaluated to a value at runtime and such produced value will be assigned to the field/attribute of a specific
- * instance of an user-defined class. 
+ * instance of an user-defined class. It also stores "nameId", which is the interned ID of the name of the 
+ * field/attribute.
  */
 struct Set : Expr, public std::enable_shared_from_this<Set>{
   // This struct here represents a "Set" expression: someObject.someProperty = someValue
@@ -428,9 +549,10 @@ struct Set : Expr, public std::enable_shared_from_this<Set>{
   // value -> someValue
   // At runtime, it will use a token of type IDENTIFIER to find out where the property with that name from the 
   // object that the expression evaluates to is stored, so it can assign the value to it.
-  const std::shared_ptr<Expr> object;
+  std::shared_ptr<Expr> object;
   const Token name;
-  const std::shared_ptr<Expr> value;
+  std::shared_ptr<Expr> value;
+  const int nameId;
 
   /**
    * @brief Constructs a Set node of the Bleach AST (Abstract Syntax Tree). 
@@ -445,7 +567,7 @@ struct Set : Expr, public std::enable_shared_from_this<Set>{
    * field/attribute.
   **/
   Set(std::shared_ptr<Expr> object, Token name, std::shared_ptr<Expr> value)
-    : object{std::move(object)}, name{std::move(name)}, value{std::move(value)}
+    : Expr{ExprKind::SET}, object{std::move(object)}, name{std::move(name)}, value{std::move(value)}, nameId{SymbolTable::intern(this->name.lexeme)}
   {}
 
   std::any accept(ExprVisitor& visitor) override{
@@ -466,11 +588,23 @@ struct Set : Expr, public std::enable_shared_from_this<Set>{
  * This struct has only two attributes. The first one is called "keyword". This attribute is the token whose 
  * lexeme is the "super" keyword. The second one is called "method". This attribute is also a token, but this is 
  * a token whose lexeme is the name of the method that is being called on the superclass of the class this 
- * expression has appeared. 
+ * expression has appeared. It also stores "methodId", which is the interned ID of the name of such method, 
+ * and "depth", which is set by the Resolver to the amount of hops between the current environment and the 
+ * environment where "super" is bound.
+ * Finally, when the class that encloses this expression is finalized, the superclass method this expression
+ * refers to is resolved and cached in "cachedMethod", together with the superclass it was resolved against
+ * ("cachedSuperclass"). If the same class declaration is executed again with a different superclass, the node
+ * is marked as "polymorphic" for good: From then on, no method is cached inside it, and the method is looked up
+ * at every evaluation.
  */
 struct Super : Expr, public std::enable_shared_from_this<Super>{
   const Token keyword;
   const Token method;
+  const int methodId;
+  int depth = -1; // Distance (in environments) to the binding of "super". Set by the Resolver.
+  std::shared_ptr<BleachFunction> cachedMethod = nullptr; // The superclass method resolved at class finalization time.
+  std::weak_ptr<BleachClass> cachedSuperclass; // The superclass against which "cachedMethod" was resolved.
+  bool polymorphic = false; // Whether the enclosing class declaration has been executed with more than one superclass.
 
   /**
    * @brief Constructs a Super node of the Bleach AST (Abstract Syntax Tree). 
@@ -482,7 +616,7 @@ struct Super : Expr, public std::enable_shared_from_this<Super>{
    * instance of a class is calling.
   **/
   Super(Token keyword, Token method)
-    : keyword{std::move(keyword)}, method{std::move(method)}
+    : Expr{ExprKind::SUPER}, keyword{std::move(keyword)}, method{std::move(method)}, methodId{SymbolTable::intern(this->method.lexeme)}
   {}
 
   std::any accept(ExprVisitor& visitor) override{
@@ -503,9 +637,9 @@ struct Super : Expr, public std::enable_shared_from_this<Super>{
  * the attribute "elseBranch", which is also an expression, is the one that will be evaluated.
  */
 struct Ternary : Expr, public std::enable_shared_from_this<Ternary>{
-  const std::shared_ptr<Expr> condition;
-  const std::shared_ptr<Expr> ifBranch;
-  const std::shared_ptr<Expr> elseBranch;
+  std::shared_ptr<Expr> condition;
+  std::shared_ptr<Expr> ifBranch;
+  std::shared_ptr<Expr> elseBranch;
 
   /**
    * @brief Constructs a Ternary node of the Bleach AST (Abstract Syntax Tree). 
@@ -520,7 +654,7 @@ struct Ternary : Expr, public std::enable_shared_from_this<Ternary>{
    * evaluated to false during runtime.
   **/
   Ternary(std::shared_ptr<Expr> condition, std::shared_ptr<Expr> ifBranch, std::shared_ptr<Expr> elseBranch)
-    : condition{std::move(condition)}, ifBranch{std::move(ifBranch)}, elseBranch{std::move(elseBranch)}
+    : Expr{ExprKind::TERNARY}, condition{std::move(condition)}, ifBranch{std::move(ifBranch)}, elseBranch{std::move(elseBranch)}
   {}
 
   std::any accept(ExprVisitor& visitor) override{
@@ -541,7 +675,7 @@ struct Ternary : Expr, public std::enable_shared_from_this<Ternary>{
  */
 struct Unary : Expr, public std::enable_shared_from_this<Unary>{
   const Token op;
-  const std::shared_ptr<Expr> right;
+  std::shared_ptr<Expr> right;
 
   /**
    * @brief Constructs an Unary node of the Bleach AST (Abstract Syntax Tree). 
@@ -553,7 +687,7 @@ struct Unary : Expr, public std::enable_shared_from_this<Unary>{
    * @param right: The right operand of the unary operator.
   **/
   Unary(Token op, std::shared_ptr<Expr> right)
-    : op{std::move(op)}, right{std::move(right)}
+    : Expr{ExprKind::UNARY}, op{std::move(op)}, right{std::move(right)}
   {}
 
   std::any accept(ExprVisitor& visitor) override{
@@ -572,9 +706,14 @@ struct Unary : Expr, public std::enable_shared_from_this<Unary>{
  * 
  * @note The act of accessing a variable is considered an expression because it produces a value: the value that
  * is bound to the variable whose lexeme of the token "name" is referencing.
+ * The Resolver stores where the accessed variable lives: If it is a local variable, the "depth" attribute holds
+ * the amount of hops between the current environment and the environment of the variable. Otherwise, "depth"
+ * is -1 and the "globalSlot" attribute holds the slot of the variable inside the global environment.
  */
 struct Variable : Expr, public std::enable_shared_from_this<Variable>{
   const Token name;
+  int depth = -1; // Distance (in environments) to the variable, if it is a local variable. Set by the Resolver.
+  int globalSlot = -1; // Slot of the variable inside the global environment, if it is a global variable. Set by the Resolver.
 
   /**
    * @brief Constructs a Variable node of the Bleach AST (Abstract Syntax Tree). 
@@ -584,7 +723,7 @@ struct Variable : Expr, public std::enable_shared_from_this<Variable>{
    * @param name: The token whose lexeme stores the name of a variable.
   **/
   Variable(Token name)
-    : name{std::move(name)}
+    : Expr{ExprKind::VARIABLE}, name{std::move(name)}
   {}
 
   std::any accept(ExprVisitor& visitor) override{
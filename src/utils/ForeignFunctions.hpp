@@ -0,0 +1,342 @@
+#pragma once
+
+#include <any>
+#include <cctype>
+#include <cmath>
+#include <climits>
+#include <cstddef>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <dlfcn.h>
+
+#include "./NativeBinding.hpp"
+#include "./ValueStack.hpp"
+
+
+/**
+ * @enum ForeignType
+ *
+ * @brief Enumerates the C types that can show up inside the signature of a foreign function:
+ * "num" (double), "int" (int), "long" (long), "str" (const char*), "buf" (double*) and "void" (only as the return
+ * type).
+**/
+enum class ForeignType{
+  NUM,
+  INT,
+  LONG,
+  STR,
+  BUF,
+  VOID,
+};
+
+/**
+ * @class ForeignLibrary
+ *
+ * @brief Runtime representation of a shared library loaded by the "std::ffi::load" native function.
+ *
+ * The ForeignLibrary class owns the handle returned by "dlopen" and closes it when the last value that refers to
+ * it (the library itself or one of its functions) goes away. Its "bind" method looks a symbol up and turns it into
+ * a native function (see the ForeignFunction class), and it's the only property of the library inside a Bleach
+ * program ("lib.bind(symbolName, signature)").
+**/
+class ForeignLibrary : public BleachNativeObject, public std::enable_shared_from_this<ForeignLibrary>{
+  private:
+    void* handle;
+    const std::string path;
+
+  public:
+    ForeignLibrary(void* handle, std::string path)
+      : handle{handle}, path{std::move(path)}
+    {}
+
+    ForeignLibrary(const ForeignLibrary&) = delete;
+    ForeignLibrary& operator=(const ForeignLibrary&) = delete;
+
+    ~ForeignLibrary(){
+      dlclose(handle);
+    }
+
+    static std::shared_ptr<ForeignLibrary> load(const std::string& path);
+    std::shared_ptr<BleachNativeFunction> bind(const std::string& symbolName, const std::string& signature);
+
+    std::any getProperty(const std::string& name) override{
+      if(name == "bind"){
+        std::shared_ptr<ForeignLibrary> library = shared_from_this();
+        return bindNative<std::shared_ptr<BleachNativeFunction>(std::string, std::string)>("bind", [library](const std::string& symbolName, const std::string& signature){
+          return library->bind(symbolName, signature);
+        });
+      }
+
+      throw NativeFunctionError{"Undefined method of a foreign library. The only available method is 'bind'."};
+    }
+
+    std::string toString() override{
+      return "<foreign library: " + path + ">";
+    }
+};
+
+/**
+ * @class ForeignFunction
+ *
+ * @brief Native function that calls a C function of a shared library.
+ *
+ * Arguments are marshalled according to the signature given to "lib.bind": Numbers become doubles ("num"), ints
+ * ("int") or longs ("long"), which must hold an integer that fits in such type, strings become "const char*" ("str") and lists of numbers are packed
+ * into an array of doubles ("buf"). The C function may write into such array, and the values are copied back into
+ * the list once it returns, so kernels can produce their results in place.
+ *
+ * The call itself does not need libffi: Under the calling conventions of x86-64 (System V) and AArch64, integer
+ * and pointer arguments are passed in general purpose registers and doubles in floating point registers, each
+ * class in order and independently of the other. So every foreign function is called through one function pointer
+ * type that takes the maximum number of register arguments of each class. Functions that need more arguments than
+ * that (or other platforms) are rejected when they are bound. An "int" argument is passed inside a whole register
+ * (the callee only reads its lower 32 bits), and only the lower 32 bits of an "int" result are kept.
+ *
+ * @note: Variadic C functions (e.g. "printf") are not supported, since they follow a different calling
+ * convention. The most common ones are rejected when they are bound (see the "variadicFunctions" set).
+**/
+class ForeignFunction : public BleachNativeFunction{
+  public:
+    static constexpr std::size_t maxIntegers = 6; // The integer registers used for arguments on x86-64 (AArch64 has 8).
+    static constexpr std::size_t maxReals = 8; // The floating point registers used for arguments on both platforms.
+
+  private:
+    using IntegerCall = long (*)(long, long, long, long, long, long, double, double, double, double, double, double, double, double);
+    using RealCall = double (*)(long, long, long, long, long, long, double, double, double, double, double, double, double, double);
+
+    std::shared_ptr<ForeignLibrary> library; // Keeps the library loaded while the function can still be called.
+    void* symbol;
+    ForeignType result;
+    std::vector<ForeignType> parameters;
+
+    std::string expected(std::size_t index, const char* description){
+      return "Argument " + std::to_string(index + 1) + " of the foreign function '" + name + "' must be " + description + ".";
+    }
+
+    /**
+     * @brief Checks whether a value is a number that holds an integer inside the received range.
+     *
+     * @param number: The value, if it's a number (nullptr otherwise).
+     * @param lowest: The lowest integer of the range.
+     * @param limit: The first integer after the range (a power of 2, so it's represented exactly by a double).
+     *
+     * @return A boolean that tells whether the number can be converted to such integer type.
+    **/
+    static bool isIntegerInRange(const double* number, double lowest, double limit){
+      return number != nullptr && std::floor(*number) == *number && *number >= lowest && *number < limit; // Also rejects NaN and infinities.
+    }
+
+  public:
+    ForeignFunction(std::shared_ptr<ForeignLibrary> library, std::string symbolName, void* symbol, ForeignType result, std::vector<ForeignType> parameters)
+      : BleachNativeFunction{std::move(symbolName), static_cast<int>(parameters.size())}, library{std::move(library)}, symbol{symbol}, result{result}, parameters{std::move(parameters)}
+    {}
+
+    std::any invoke(Interpreter& interpreter, const Token& paren, ArgumentSpan arguments) override{
+      checkArity(paren, arguments);
+
+      long integers[maxIntegers] = {};
+      double reals[maxReals] = {};
+      std::size_t integerCount = 0;
+      std::size_t realCount = 0;
+      std::vector<std::vector<double>> buffers; // Reserved up front, so the pointers handed to the C function stay valid.
+      buffers.reserve(parameters.size());
+
+      for(std::size_t i = 0; i < parameters.size(); i++){
+        std::any& argument = arguments[i];
+
+        switch(parameters[i]){
+          case ForeignType::NUM:
+            if(argument.type() != typeid(double)){
+              throw BleachRuntimeError{location(paren), expected(i, "a number")};
+            }
+            reals[realCount++] = *std::any_cast<double>(&argument);
+            break;
+          case ForeignType::INT:{
+            const double* number = std::any_cast<double>(&argument);
+            if(!isIntegerInRange(number, INT_MIN, -static_cast<double>(INT_MIN))){
+              throw BleachRuntimeError{location(paren), expected(i, "an integer that fits in 32 bits")};
+            }
+            integers[integerCount++] = static_cast<int>(*number);
+            break;
+          }
+          case ForeignType::LONG:{
+            const double* number = std::any_cast<double>(&argument);
+            if(!isIntegerInRange(number, static_cast<double>(LONG_MIN), -static_cast<double>(LONG_MIN))){
+              throw BleachRuntimeError{location(paren), expected(i, "an integer that fits in 64 bits")};
+            }
+            integers[integerCount++] = static_cast<long>(*number);
+            break;
+          }
+          case ForeignType::STR:
+            if(argument.type() != typeid(std::string)){
+              throw BleachRuntimeError{location(paren), expected(i, "a string")};
+            }
+            integers[integerCount++] = reinterpret_cast<long>(std::any_cast<std::string>(&argument)->c_str());
+            break;
+          case ForeignType::BUF:{
+            if(argument.type() != typeid(std::shared_ptr<std::vector<std::any>>)){
+              throw BleachRuntimeError{location(paren), expected(i, "a list of numbers")};
+            }
+            const auto& list = *std::any_cast<std::shared_ptr<std::vector<std::any>>>(&argument);
+            std::vector<double>& buffer = buffers.emplace_back();
+            buffer.reserve(list->size());
+            for(const std::any& element : *list){
+              if(element.type() != typeid(double)){
+                throw BleachRuntimeError{location(paren), expected(i, "a list of numbers")};
+              }
+              buffer.push_back(*std::any_cast<double>(&element));
+            }
+            integers[integerCount++] = reinterpret_cast<long>(buffer.data());
+            break;
+          }
+          case ForeignType::VOID:
+            break;
+        }
+      }
+
+      std::any value = nullptr;
+      if(result == ForeignType::NUM){
+        value = reinterpret_cast<RealCall>(symbol)(integers[0], integers[1], integers[2], integers[3], integers[4], integers[5], reals[0], reals[1], reals[2], reals[3], reals[4], reals[5], reals[6], reals[7]);
+      }else{
+        long returned = reinterpret_cast<IntegerCall>(symbol)(integers[0], integers[1], integers[2], integers[3], integers[4], integers[5], reals[0], reals[1], reals[2], reals[3], reals[4], reals[5], reals[6], reals[7]);
+        if(result == ForeignType::INT){
+          value = static_cast<double>(static_cast<int>(returned)); // The upper 32 bits of the register are unspecified.
+        }else if(result == ForeignType::LONG){
+          value = static_cast<double>(returned);
+        }else if(result == ForeignType::STR && returned != 0){
+          value = std::string{reinterpret_cast<const char*>(returned)};
+        }
+      }
+
+      std::size_t buffer = 0;
+      for(std::size_t i = 0; i < parameters.size(); i++){ // Copies the contents of the buffers back into their lists.
+        if(parameters[i] == ForeignType::BUF){
+          auto& list = *std::any_cast<std::shared_ptr<std::vector<std::any>>>(&arguments[i]);
+          for(std::size_t j = 0; j < list->size(); j++){
+            (*list)[j] = buffers[buffer][j];
+          }
+          buffer++;
+        }
+      }
+
+      return value;
+    }
+};
+
+/**
+ * @brief Parses the name of a type inside the signature of a foreign function.
+ *
+ * @param name: The name of the type.
+ *
+ * @return The corresponding C type.
+**/
+inline ForeignType parseForeignType(const std::string& name){
+  if(name == "num"){
+    return ForeignType::NUM;
+  }else if(name == "int"){
+    return ForeignType::INT;
+  }else if(name == "long"){
+    return ForeignType::LONG;
+  }else if(name == "str"){
+    return ForeignType::STR;
+  }else if(name == "buf"){
+    return ForeignType::BUF;
+  }else if(name == "void"){
+    return ForeignType::VOID;
+  }
+
+  throw NativeFunctionError{"Unknown type '" + name + "' inside the signature of a foreign function. The available types are 'num', 'int', 'long', 'str', 'buf' and 'void'."};
+}
+
+/**
+ * @brief Loads a shared library (see the "std::ffi::load" native function).
+ *
+ * @param path: The path of the shared library, or a name that the dynamic linker can find (e.g. "libm.so.6").
+ *
+ * @return The loaded library.
+**/
+inline std::shared_ptr<ForeignLibrary> ForeignLibrary::load(const std::string& path){
+  void* handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+  if(handle == nullptr){
+    const char* reason = dlerror();
+    throw NativeFunctionError{"Could not load the shared library '" + path + "': " + (reason != nullptr ? reason : "unknown error") + "."};
+  }
+
+  return std::make_shared<ForeignLibrary>(handle, path);
+}
+
+/**
+ * @brief Looks a symbol up inside the library and turns it into a native function.
+ *
+ * @param symbolName: The name of the C function.
+ * @param signature: The signature of the C function, written as "result(parameter, ...)" with the types listed
+ * in the ForeignType enum (e.g. "num(num, num)" or "void(buf, int)").
+ *
+ * @return The native function that calls the C function.
+**/
+inline std::shared_ptr<BleachNativeFunction> ForeignLibrary::bind(const std::string& symbolName, const std::string& signature){
+#if !defined(__x86_64__) && !defined(__aarch64__)
+  throw NativeFunctionError{"Foreign functions are only supported on x86-64 and AArch64."};
+#endif
+  static const std::set<std::string> variadicFunctions = { // Common variadic functions of the C library, which cannot be called through a foreign function.
+    "printf", "fprintf", "dprintf", "sprintf", "snprintf", "asprintf",
+    "scanf", "fscanf", "sscanf",
+    "execl", "execle", "execlp",
+    "fcntl", "ioctl", "open", "openat", "prctl", "syscall", "syslog"
+  };
+  if(variadicFunctions.count(symbolName) != 0){
+    throw NativeFunctionError{"The C function '" + symbolName + "' is variadic. Variadic functions cannot be called through a foreign function."};
+  }
+
+  std::string compact; // The signature without whitespace.
+  for(char ch : signature){
+    if(!std::isspace(static_cast<unsigned char>(ch))){
+      compact += ch;
+    }
+  }
+
+  std::size_t open = compact.find('(');
+  if(open == std::string::npos || compact.back() != ')'){
+    throw NativeFunctionError{"Invalid signature '" + signature + "'. Expected something like 'num(num, int)'."};
+  }
+
+  ForeignType result = parseForeignType(compact.substr(0, open));
+  std::vector<ForeignType> parameters;
+  std::size_t integerCount = 0;
+  std::size_t realCount = 0;
+  std::string list = compact.substr(open + 1, compact.size() - open - 2);
+
+  std::size_t start = 0;
+  while(!list.empty() && start <= list.size()){
+    std::size_t comma = list.find(',', start);
+    std::string name = list.substr(start, comma == std::string::npos ? std::string::npos : comma - start);
+    ForeignType parameter = parseForeignType(name);
+
+    if(parameter == ForeignType::VOID){
+      throw NativeFunctionError{"The 'void' type can only be used as the return type of a foreign function."};
+    }
+    (parameter == ForeignType::NUM ? realCount : integerCount)++;
+    parameters.push_back(parameter);
+
+    if(comma == std::string::npos){
+      break;
+    }
+    start = comma + 1;
+  }
+
+  if(integerCount > ForeignFunction::maxIntegers || realCount > ForeignFunction::maxReals){
+    throw NativeFunctionError{"Foreign functions can receive at most " + std::to_string(ForeignFunction::maxIntegers) + " arguments of the 'int', 'long', 'str' and 'buf' types and " + std::to_string(ForeignFunction::maxReals) + " arguments of the 'num' type."};
+  }
+
+  dlerror(); // Clears any previous error.
+  void* symbol = dlsym(handle, symbolName.c_str());
+  if(symbol == nullptr){
+    throw NativeFunctionError{"Could not find the symbol '" + symbolName + "' inside the shared library '" + path + "'."};
+  }
+
+  return std::make_shared<ForeignFunction>(shared_from_this(), symbolName, symbol, result, std::move(parameters));
+}
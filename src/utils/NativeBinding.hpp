@@ -0,0 +1,332 @@
+#pragma once
+
+#include <any>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "./BleachCallable.hpp"
+#include "./Token.hpp"
+#include "./ValueStack.hpp"
+#include "../error/BleachRuntimeError.hpp"
+
+
+class Interpreter;
+
+/**
+ * @class NativeFunctionError
+ *
+ * @brief Error thrown by the implementation of a native function. The native function that has been called
+ * turns it into a BleachRuntimeError that points at its call.
+**/
+class NativeFunctionError : public std::runtime_error{
+  public:
+    using std::runtime_error::runtime_error;
+};
+
+/**
+ * @class BleachNativeFunction
+ *
+ * @brief Base class of every native function of the Bleach language.
+ *
+ * The BleachNativeFunction class holds the name and the arity of a native function, so the Interpreter class
+ * can recognize every native function through a single type (a "std::shared_ptr<BleachNativeFunction>") and call
+ * it through the "invoke" method, which receives a view of the arguments (see the ArgumentSpan struct) instead of
+ * a copy of them.
+ * Most native functions are not written by hand: They are generated from a plain C++ function by the
+ * "bindNative" function (see the BoundNativeFunction class).
+**/
+class BleachNativeFunction : public BleachCallable{
+  protected:
+    const std::string name; // The name of the native function (e.g. "std::math::pow").
+    const int expectedArity; // -1 means that the native function expects a variable number of arguments.
+    bool pure = false; // Whether the native function has no side effects and always returns the same value for the same arguments.
+
+    /**
+     * @brief Builds the token that is used to report the runtime errors that happen inside a call of the native
+     * function.
+     *
+     * @param paren: The token that represents the closing parenthesis of the call.
+     *
+     * @return A token that holds the name of the native function and the line of its call.
+    **/
+    Token location(const Token& paren){
+      return Token{TokenType::IDENTIFIER, name, toString(), paren.line};
+    }
+
+    /**
+     * @brief Checks whether the native function has received the expected number of arguments.
+     *
+     * @param paren: The token that represents the closing parenthesis of the call.
+     * @param arguments: The list of arguments of the call.
+    **/
+    void checkArity(const Token& paren, ArgumentSpan arguments){
+      if(expectedArity != -1 && arguments.size() != static_cast<std::size_t>(expectedArity)){
+        throw BleachRuntimeError{location(paren), "Invalid number of arguments. Expected " + std::to_string(expectedArity) + " arguments but received " + std::to_string(arguments.size()) + " arguments."};
+      }
+
+      return;
+    }
+
+  public:
+    BleachNativeFunction(std::string name, int expectedArity)
+      : name{std::move(name)}, expectedArity{expectedArity}
+    {}
+
+    const std::string& getName() const{
+      return name;
+    }
+
+    int arity() override{
+      return expectedArity;
+    }
+
+    bool isPure() const{
+      return pure;
+    }
+
+    /**
+     * @brief Marks the native function as pure. Calling a native function that is not pure invalidates the
+     * values of the common subexpressions that have been computed so far (see the Cached struct), so a pure
+     * native function can be reused by such subexpressions.
+    **/
+    void markPure(){
+      pure = true;
+
+      return;
+    }
+
+    /**
+     * @brief Required by the BleachCallable class, but never used: Native functions are always called with the 
+     * token of their call (see the method below), since they report their errors at it.
+    **/
+    std::any call(Interpreter& interpreter, ArgumentSpan arguments) override{
+      throw std::logic_error{"The '" + name + "' native function must be called with the token of its call."};
+    }
+
+    std::any call(Interpreter& interpreter, const Token& paren, ArgumentSpan arguments) override{
+      return invoke(interpreter, paren, arguments);
+    }
+
+    /**
+     * @brief Calls the native function. The arguments may be moved out of the span.
+     *
+     * @param interpreter: The instance of the Interpreter class that runs the program.
+     * @param paren: The token that represents the closing parenthesis of the call.
+     * @param arguments: The list of arguments of the call.
+     *
+     * @return The value returned by the native function.
+    **/
+    virtual std::any invoke(Interpreter& interpreter, const Token& paren, ArgumentSpan arguments) = 0;
+
+    std::string toString() override{
+      return "<native function: " + name + ">";
+    }
+};
+
+/**
+ * @class BleachNativeObject
+ *
+ * @brief Base class of the values that are implemented in C++ but are neither native functions nor one of the
+ * built-in types (e.g. the libraries loaded by "std::ffi::load" or the objects created by a native module).
+ *
+ * The Interpreter class only knows them through this class: Accessing a property ("object.name") calls the
+ * "getProperty" method, which usually returns a native function that has captured the object, and printing one
+ * calls the "toString" method. Errors are reported by throwing a NativeFunctionError.
+**/
+class BleachNativeObject{
+  public:
+    virtual ~BleachNativeObject() = default;
+
+    /**
+     * @brief Looks a property of the object up.
+     *
+     * @param name: The name of the property.
+     *
+     * @return The value of the property.
+    **/
+    virtual std::any getProperty(const std::string& name) = 0;
+
+    virtual std::string toString() = 0;
+};
+
+/**
+ * @struct NativeArgument
+ *
+ * @brief Describes how a value of a Bleach program is checked and converted into an argument of type "T" of a
+ * native function. Only the types below can be used as parameters of a bound native function.
+**/
+template<typename T>
+struct NativeArgument;
+
+template<>
+struct NativeArgument<double>{
+  static constexpr const char* description = "a number";
+
+  static bool matches(const std::any& value){
+    return value.type() == typeid(double);
+  }
+
+  static double get(std::any& value){
+    return *std::any_cast<double>(&value);
+  }
+};
+
+template<>
+struct NativeArgument<bool>{
+  static constexpr const char* description = "a boolean";
+
+  static bool matches(const std::any& value){
+    return value.type() == typeid(bool);
+  }
+
+  static bool get(std::any& value){
+    return *std::any_cast<bool>(&value);
+  }
+};
+
+template<>
+struct NativeArgument<std::string>{
+  static constexpr const char* description = "a string";
+
+  static bool matches(const std::any& value){
+    return value.type() == typeid(std::string);
+  }
+
+  static std::string&& get(std::any& value){
+    return std::move(*std::any_cast<std::string>(&value)); // The arguments are thrown away after the call, so their strings can be moved.
+  }
+};
+
+template<>
+struct NativeArgument<std::shared_ptr<std::vector<std::any>>>{
+  static constexpr const char* description = "a list";
+
+  static bool matches(const std::any& value){
+    return value.type() == typeid(std::shared_ptr<std::vector<std::any>>);
+  }
+
+  static std::shared_ptr<std::vector<std::any>>&& get(std::any& value){
+    return std::move(*std::any_cast<std::shared_ptr<std::vector<std::any>>>(&value));
+  }
+};
+
+template<>
+struct NativeArgument<std::any>{
+  static constexpr const char* description = "any value";
+
+  static bool matches(const std::any& value){
+    return true;
+  }
+
+  static std::any&& get(std::any& value){
+    return std::move(value);
+  }
+};
+
+/**
+ * @class BoundNativeFunction
+ *
+ * @brief Native function generated from a plain C++ function (or lambda) by the "bindNative" function.
+ *
+ * The signature of the native function ("Result(Parameters...)") is known at compile time, so the number of
+ * arguments, the type of each argument (see the NativeArgument struct), their conversion and the messages of
+ * the runtime errors are all generated by the compiler. The implementation may also receive the instance of the
+ * Interpreter class as its first parameter (before the ones listed in the signature), and it reports its own
+ * errors by throwing a NativeFunctionError. The value it returns is converted into "Result" before it's stored,
+so an implementation may return, for instance, a derived class of the BleachNativeObject class.
+**/
+template<typename Signature, typename Implementation>
+class BoundNativeFunction;
+
+template<typename Result, typename... Parameters, typename Implementation>
+class BoundNativeFunction<Result(Parameters...), Implementation> : public BleachNativeFunction{
+  private:
+    Implementation implementation;
+
+    static std::string ordinal(std::size_t index){
+      static const char* const ordinals[] = {"first", "second", "third", "fourth", "fifth"};
+
+      return index < 5 ? ordinals[index] : std::to_string(index + 1) + "th";
+    }
+
+    template<typename Parameter>
+    void checkArgument(const Token& paren, const std::any& argument, std::size_t index){
+      using Argument = NativeArgument<std::decay_t<Parameter>>;
+
+      if(!Argument::matches(argument)){
+        std::string position = sizeof...(Parameters) == 1 ? "The argument" : "The " + ordinal(index) + " argument";
+        throw BleachRuntimeError{location(paren), position + " of the '" + name + "' function must be " + Argument::description + "."};
+      }
+
+      return;
+    }
+
+    template<std::size_t... Indices>
+    std::any invokeWith(Interpreter& interpreter, const Token& paren, ArgumentSpan arguments, std::index_sequence<Indices...>){
+      (checkArgument<Parameters>(paren, arguments[Indices], Indices), ...);
+
+      try{
+        if constexpr(std::is_invocable_v<Implementation&, Interpreter&, Parameters...>){
+          if constexpr(std::is_void_v<Result>){
+            implementation(interpreter, NativeArgument<std::decay_t<Parameters>>::get(arguments[Indices])...);
+            return nullptr;
+          }else{
+            return Result(implementation(interpreter, NativeArgument<std::decay_t<Parameters>>::get(arguments[Indices])...));
+          }
+        }else{
+          if constexpr(std::is_void_v<Result>){
+            implementation(NativeArgument<std::decay_t<Parameters>>::get(arguments[Indices])...);
+            return nullptr;
+          }else{
+            return Result(implementation(NativeArgument<std::decay_t<Parameters>>::get(arguments[Indices])...));
+          }
+        }
+      }catch(const NativeFunctionError& error){
+        throw BleachRuntimeError{location(paren), error.what()};
+      }
+    }
+
+  public:
+    BoundNativeFunction(std::string name, Implementation implementation)
+      : BleachNativeFunction{std::move(name), static_cast<int>(sizeof...(Parameters))}, implementation{std::move(implementation)}
+    {}
+
+    std::any invoke(Interpreter& interpreter, const Token& paren, ArgumentSpan arguments) override{
+      checkArity(paren, arguments);
+
+      return invokeWith(interpreter, paren, arguments, std::index_sequence_for<Parameters...>{});
+    }
+};
+
+/**
+ * @brief Generates a native function from a plain C++ function (or lambda). For example:
+ * "bindNative<double(double, double)>("std::math::pow", ...)".
+ *
+ * @param name: The name of the native function.
+ * @param implementation: The function that implements the native function.
+ *
+ * @return The generated native function.
+**/
+template<typename Signature, typename Implementation>
+std::shared_ptr<BleachNativeFunction> bindNative(std::string name, Implementation implementation){
+  return std::make_shared<BoundNativeFunction<Signature, Implementation>>(std::move(name), std::move(implementation));
+}
+
+/**
+ * @brief Marks a native function as pure (see the "markPure" method of the BleachNativeFunction class). For
+ * example: "pureNative(bindNative<double(double)>("std::math::sqrt", ...))".
+ *
+ * @param native: The native function.
+ *
+ * @return The same native function.
+**/
+inline std::shared_ptr<BleachNativeFunction> pureNative(std::shared_ptr<BleachNativeFunction> native){
+  native->markPure();
+
+  return native;
+}
@@ -3,626 +3,203 @@
 #include <any>
 #include <cmath>
 #include <chrono>
+#include <cstddef>
 #include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <list>
+#include <memory>
 #include <random>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
-#include "./BleachCallable.hpp"
+#include "./NativeBinding.hpp"
+#include "./Streams.hpp"
+#include "./Token.hpp"
 #include "../error/BleachRuntimeError.hpp"
 
 
 class Interpreter;
 
-// std::chrono::clock
-class NativeClock : public BleachCallable{
-  public:
-    int arity() override{
-      return 0;
-    }
-
-    std::any call(Interpreter& interpreter, std::vector<std::any> arguments) override{
-      std::cout << "No implementation of this method available for the 'NativeClock' class." << std::endl;
-      
-      return {};
-    } 
-    
-    std::any call(Interpreter& interpreter, Token paren, std::vector<std::any> arguments) override{
-      if(arguments.size() != 0){
-        const Token functionName{TokenType::IDENTIFIER, "std::chrono::clock", toString(), paren.line};
-        throw BleachRuntimeError{functionName, "Invalid number of arguments. Expected " + std::to_string(arity()) + " arguments but received " + std::to_string(arguments.size()) + " arguments."};
-      }
+// Implementations of the native functions that are generated by the "bindNative" function. Each of them is
+// registered inside the constructor of the Interpreter class.
 
-      auto now = std::chrono::high_resolution_clock::now();
-      auto duration = now.time_since_epoch();
-
-      return std::chrono::duration<double>(duration).count();
-    }
+// std::chrono::clock
+inline double nativeClock(){
+  auto now = std::chrono::high_resolution_clock::now();
+  auto duration = now.time_since_epoch();
 
-    std::string toString() override{
-      return "<native function: std::chrono::clock>";
-    }
-};
+  return std::chrono::duration<double>(duration).count();
+}
 
 // std::io::readLine
-class NativeReadLine : public BleachCallable{
-  public:
-    int arity() override{
-      return 0;
-    }
-
-    std::any call(Interpreter& interpreter, std::vector<std::any> arguments) override{
-      std::cout << "No implementation of this method available for the 'NativeReadLine' class." << std::endl;
-      
-      return {};
-    }
+inline std::string nativeReadLine(){
+  std::string lineContent;
+  std::getline(std::cin, lineContent);
 
-    std::any call(Interpreter& interpreter, Token paren, std::vector<std::any> arguments) override{
-      if(arguments.size() != 0){
-        Token functionName{TokenType::IDENTIFIER, "std::io::ReadLine", toString(), paren.line};
-        throw BleachRuntimeError{functionName, "Invalid number of arguments. Expected " + std::to_string(arity()) + " arguments but received " + std::to_string(arguments.size()) + " arguments."};
-      }
+  return lineContent;
+}
 
-      std::string lineContent;
-      std::getline(std::cin, lineContent);
+inline bool hasTxtExtension(const std::string& filePath){
+  const std::string extension = ".txt";
 
-      return lineContent;
-    }
+  if(filePath.length() >= extension.length()){
+    return (filePath.rfind(extension) == (filePath.length() - extension.length()));
+  }
 
-    std::string toString() override{
-      return "<native function: std::io::readLine>";
-    } 
-};
+  return false;
+}
 
 // std::io::fileRead
-class NativeFileRead : public BleachCallable{
-  public:
-    int arity() override{
-      return 1;
-    }
-
-    std::any call(Interpreter& interpreter, std::vector<std::any> arguments) override{
-      std::cout << "No implementation of this method available for the 'NativeFileRead' class." << std::endl;
-      
-      return {};
-    }
-
-    bool hasTxtExtension(std::string filePath){
-      const std::string extension = ".txt";
-
-      if (filePath.length() >= extension.length()) {
-          return (filePath.rfind(extension) == (filePath.length() - extension.length()));
-      }
+inline std::string nativeFileRead(const std::string& filePath){ // Can either be complete/full path or relative path.
+  if(!hasTxtExtension(filePath)){
+    throw NativeFunctionError{"The 'std::io::fileRead' native function can only read the contents of files with a '.txt' extension."};
+  }
 
-      return false;
-    }
+  std::ifstream file(filePath);
+  if(!file){
+    throw NativeFunctionError{"Could not open the provided file: '" + filePath + "'."};
+  }
 
-    std::any call(Interpreter& interpreter, Token paren, std::vector<std::any> arguments) override{
-      Token functionName{TokenType::IDENTIFIER, "std::io::fileRead", toString(), paren.line};
-      if(arguments.size() != 1){
-        throw BleachRuntimeError{functionName, "Invalid number of arguments. Expected " + std::to_string(arity()) + " arguments but received " + std::to_string(arguments.size()) + " arguments."};
-      }
-
-      if(arguments[0].type() != typeid(std::string)){
-        throw BleachRuntimeError{functionName, "Argument of the 'std::io::fileRead' function must be a string."};
-      }
+  std::ostringstream fileContent;
+  fileContent << file.rdbuf();
 
-      std::string filePath = std::any_cast<std::string>(arguments[0]); // Can either be complete/full path or relative path.
-
-      if(!hasTxtExtension(filePath)){
-        throw BleachRuntimeError{functionName, "The 'std::io::fileRead' native function can only read the contents of files with a '.txt' extension."};
-      }
-
-      std::ifstream file(filePath);
-      if(!file){
-        throw BleachRuntimeError{functionName, "Could not open the provided file: '" + filePath + "'."};
-      }
-
-      std::ostringstream fileContent;
-      fileContent << file.rdbuf();
-
-      return fileContent.str();
-    }
-
-    std::string toString() override{
-      return "<native function: std::io::fileRead>";
-    }
-};
+  return fileContent.str();
+}
 
 // std::io::fileWrite
-class NativeFileWrite : public BleachCallable{
-  public:
-    int arity() override{
-      return 4;
-    }
-
-    std::any call(Interpreter& interpreter, std::vector<std::any> arguments) override{
-      std::cout << "No implementation of this method available for the 'NativeFileWrite' class." << std::endl;
-      
-      return {};
-    }
-
-    bool hasTxtExtension(std::string filePath){
-      const std::string extension = ".txt";
-
-      if (filePath.length() >= extension.length()) {
-          return (filePath.rfind(extension) == (filePath.length() - extension.length()));
-      }
-
-      return false;
-    }
-
-    std::any call(Interpreter& interpreter, Token paren, std::vector<std::any> arguments) override{
-      Token functionName{TokenType::IDENTIFIER, "std::io::fileWrite", toString(), paren.line};
-      if(arguments.size() != 4){
-        throw BleachRuntimeError{functionName, "Invalid number of arguments. Expected " + std::to_string(arity()) + " arguments but received " + std::to_string(arguments.size()) + " arguments."};
-      }
-
-      if(arguments[0].type() != typeid(std::string) || arguments[1].type() != typeid(std::string) || arguments[2].type() != typeid(std::string) || arguments[3].type() != typeid(bool)){
-        throw BleachRuntimeError{functionName, "The first 3 arguments of the 'std::io::fileWrite' function must be all strings. The fourth and last one must be a boolean."};
-      }
-
-      std::string filePath = std::any_cast<std::string>(arguments[0]); // Can either be complete/full path or relative path.
-      std::string openMode = std::any_cast<std::string>(arguments[1]); // Can either be "w" (write) or "a" (append).
-      std::string contentToWrite = std::any_cast<std::string>(arguments[2]); // The content that will be written to the destination file.
-      bool insertNewLine = std::any_cast<bool>(arguments[3]); // Boolean that signals whether or not a newline must be added to the file after writing the provided content.
-
-      if(!hasTxtExtension(filePath)){
-        throw BleachRuntimeError{functionName, "The 'std::io::fileWrite' native function can only write content to files with a '.txt' extension."};
-      }
-      if(openMode != "w" && openMode != "a"){
-        throw BleachRuntimeError{functionName, "The 'std::io::fileWrite' native function only has two modes of opening and writing to a file: 'a' (append) or 'w' (write)."};
-      }
-
-      std::ofstream file(filePath, openMode == "a" ? std::ios::app : std::ios::out);
-      if(!file){
-        throw BleachRuntimeError{functionName, "Could not open the provided file: '" + filePath + "' in the given mode."};
-      }
-
-      file << contentToWrite;
-      if(!file){
-        throw BleachRuntimeError{functionName, "Could not write the content to the provided file: '" + filePath + "' in the given mode."};
-      }
-
-      if(insertNewLine){
-        file << "\n";
-      }
-
-      return nullptr;
-    }
-
-    std::string toString() override{
-      return "<native function: std::io::fileWrite>";
-    }
-};
-
-// std::math::abs
-class NativeAbsoluteValue : public BleachCallable{
-  public:
-    int arity() override{
-      return 1;
-    }
-
-    std::any call(Interpreter& interpreter, std::vector<std::any> arguments) override{
-      std::cout << "No implementation of this method available for the 'NativeAbsoluteValue' class." << std::endl;
-      
-      return {};
-    }
-
-    std::any call(Interpreter& interpreter, Token paren, std::vector<std::any> arguments) override{
-      Token functionName{TokenType::IDENTIFIER, "std::math::abs", toString(), paren.line};
-      if(arguments.size() != 1){
-        throw BleachRuntimeError{functionName, "Invalid number of arguments. Expected " + std::to_string(arity()) + " arguments but received " + std::to_string(arguments.size()) + " arguments."};
-      }
-
-      if(arguments[0].type() != typeid(double)){
-        throw BleachRuntimeError{functionName, "Argument of the 'std::math::abs' function must be a number."};
-      }
-
-      double number = std::any_cast<double>(arguments[0]);
-
-      return std::fabs(number);
-    }
-
-    std::string toString() override{
-      return "<native function: std::math::abs>";
-    }
-};
+// "openMode" can either be "w" (write) or "a" (append). "insertNewLine" signals whether or not a newline must be
+// added to the file after writing the provided content.
+inline void nativeFileWrite(const std::string& filePath, const std::string& openMode, const std::string& contentToWrite, bool insertNewLine){
+  if(!hasTxtExtension(filePath)){
+    throw NativeFunctionError{"The 'std::io::fileWrite' native function can only write content to files with a '.txt' extension."};
+  }
+  if(openMode != "w" && openMode != "a"){
+    throw NativeFunctionError{"The 'std::io::fileWrite' native function only has two modes of opening and writing to a file: 'a' (append) or 'w' (write)."};
+  }
+
+  std::ofstream file(filePath, openMode == "a" ? std::ios::app : std::ios::out);
+  if(!file){
+    throw NativeFunctionError{"Could not open the provided file: '" + filePath + "' in the given mode."};
+  }
+
+  file << contentToWrite;
+  if(!file){
+    throw NativeFunctionError{"Could not write the content to the provided file: '" + filePath + "' in the given mode."};
+  }
+
+  if(insertNewLine){
+    file << "\n";
+  }
+
+  return;
+}
 
 // std::math::ceil
-class NativeCeil : public BleachCallable{
-  public:
-    int arity() override{
-      return 1;
-    }
-
-    std::any call(Interpreter& interpreter, std::vector<std::any> arguments) override{
-      std::cout << "No implementation of this method available for the 'NativeCeil' class." << std::endl;
-      
-      return {};
-    }
-
-    std::any call(Interpreter& interpreter, Token paren, std::vector<std::any> arguments) override{
-      Token functionName{TokenType::IDENTIFIER, "std::math::ceil", toString(), paren.line};
-
-      if(arguments.size() != 1){
-        throw BleachRuntimeError{functionName, "Invalid number of arguments. Expected " + std::to_string(arity()) + " arguments but received " + std::to_string(arguments.size()) + " arguments."};
-      }
-
-      if(arguments[0].type() != typeid(double)){
-        throw BleachRuntimeError{functionName, "The argument of the 'std::math::ceil' function must be a number."};
-      }
-
-      double value = std::any_cast<double>(arguments[0]);
-
-      return std::ceil(value) == -0 ? 0 : std::ceil(value);
-    }
-
-    std::string toString() override{
-      return "<native function: std::math::ceil>";
-    }
-};
-
-// std::math::floor
-class NativeFloor : public BleachCallable{
-  public:
-    int arity() override{
-      return 1;
-    }
-
-    std::any call(Interpreter& interpreter, std::vector<std::any> arguments) override{
-      std::cout << "No implementation of this method available for the 'NativeFloor' class." << std::endl;
-      
-      return {};
-    }
-
-    std::any call(Interpreter& interpreter, Token paren, std::vector<std::any> arguments) override{
-      Token functionName{TokenType::IDENTIFIER, "std::math::floor", toString(), paren.line};
-
-      if(arguments.size() != 1){
-        throw BleachRuntimeError{functionName, "Invalid number of arguments. Expected " + std::to_string(arity()) + " arguments but received " + std::to_string(arguments.size()) + " arguments."};
-      }
-
-      if(arguments[0].type() != typeid(double)){
-        throw BleachRuntimeError{functionName, "The argument of the 'std::math::floor' function must be a number."};
-      }
-
-      double value = std::any_cast<double>(arguments[0]);
-
-      return std::floor(value);
-    }
-
-    std::string toString() override{
-      return "<native function: std::math::floor>";
-    }
-};
+inline double nativeCeil(double value){
+  return std::ceil(value) == -0 ? 0 : std::ceil(value);
+}
 
 // std::math::log
-class NativeLogarithm : public BleachCallable{
-  public:
-    int arity() override{
-      return 2;
-    }
-
-    std::any call(Interpreter& interpreter, std::vector<std::any> arguments) override{
-      std::cout << "No implementation of this method available for the 'NativeLogarithm' class." << std::endl;
-      
-      return {};
-    }
-
-    std::any call(Interpreter& interpreter, Token paren, std::vector<std::any> arguments) override{
-      const double epsilon = 1e-9;
-      Token functionName{TokenType::IDENTIFIER, "std::math::log", toString(), paren.line};
-
-      if(arguments.size() != 2){
-        throw BleachRuntimeError{functionName, "Invalid number of arguments. Expected " + std::to_string(arity()) + " arguments but received " + std::to_string(arguments.size()) + " arguments."};
-      }
+inline double nativeLogarithm(double base, double argument){
+  const double epsilon = 1e-9;
 
-      if(arguments[0].type() != typeid(double) || arguments[1].type() != typeid(double)){
-        throw BleachRuntimeError{functionName, "The two arguments of the 'std::math::log' function must be numbers."};
-      }
-
-      double base = std::any_cast<double>(arguments[0]);
-      double argument = std::any_cast<double>(arguments[1]);
-
-      if(std::fabs(base - 1) <= epsilon || std::signbit(base)){
-        throw BleachRuntimeError{functionName, "The first argument (the base of the logarithm) of the 'std::math::log' must be a positive number and different from 1."};
-      }
-      if(std::signbit(argument)){
-        throw BleachRuntimeError{functionName, "The second argument (the argument of the logarithm) of the 'std::math::log' must be a positive number."};
-      }
+  if(std::fabs(base - 1) <= epsilon || std::signbit(base)){
+    throw NativeFunctionError{"The first argument (the base of the logarithm) of the 'std::math::log' must be a positive number and different from 1."};
+  }
+  if(std::signbit(argument)){
+    throw NativeFunctionError{"The second argument (the argument of the logarithm) of the 'std::math::log' must be a positive number."};
+  }
 
-      double num = std::log10(argument);
-      double den = std::log10(base);
+  double num = std::log10(argument);
+  double den = std::log10(base);
 
-      if(std::fabs(den) <= epsilon){
-        throw BleachRuntimeError{functionName, "Internal error while computing the logarithm of " + std::to_string(argument) + " in base " + std::to_string(base) + "."};
-      }
+  if(std::fabs(den) <= epsilon){
+    throw NativeFunctionError{"Internal error while computing the logarithm of " + std::to_string(argument) + " in base " + std::to_string(base) + "."};
+  }
 
-      return (num/den);
-    }
-
-    std::string toString() override{
-      return "<native function: std::math::log>";
-    }
-};
-
-// std::math::pow
-class NativeExponentiation : public BleachCallable{
-  public:
-    int arity() override{
-      return 2;
-    }
-
-    std::any call(Interpreter& interpreter, std::vector<std::any> arguments) override{
-      std::cout << "No implementation of this method available for the 'NativeExponentiation' class." << std::endl;
-      
-      return {};
-    }
-
-    std::any call(Interpreter& interpreter, Token paren, std::vector<std::any> arguments) override{
-      Token functionName{TokenType::IDENTIFIER, "std::math::pow", toString(), paren.line};
-      if(arguments.size() != 2){
-        throw BleachRuntimeError{functionName, "Invalid number of arguments. Expected " + std::to_string(arity()) + " arguments but received " + std::to_string(arguments.size()) + " arguments."};
-      }
-
-      if(arguments[0].type() != typeid(double) || arguments[1].type() != typeid(double)){
-        throw BleachRuntimeError{functionName, "The two arguments of the 'std::math::pow' function must be numbers."};
-      }
-
-      double base = std::any_cast<double>(arguments[0]);
-      double exponent = std::any_cast<double>(arguments[1]);
-
-      return std::pow(base, exponent);
-    }
-
-    std::string toString() override{
-      return "<native function: std::math::pow>";
-    }
-};
+  return (num/den);
+}
 
 // std::math::sqrt
-class NativeSquareRoot : public BleachCallable{
-  public:
-    int arity() override{
-      return 1;
-    }
+inline double nativeSquareRoot(double radicand){
+  if(radicand < 0){
+    throw NativeFunctionError{"Argument of the 'std::math::sqrt' function cannot be a negative number."};
+  }
 
-    std::any call(Interpreter& interpreter, std::vector<std::any> arguments) override{
-      std::cout << "No implementation of this method available for the 'NativeSquareRoot' class." << std::endl;
-      
-      return {};
-    }
-
-   std::any call(Interpreter& interpreter, Token paren, std::vector<std::any> arguments) override{
-      Token functionName{TokenType::IDENTIFIER, "std::math::sqrt", this->toString(), paren.line};
-      if(arguments.size() != 1){
-        throw BleachRuntimeError{functionName, "Invalid number of arguments. Expected " + std::to_string(arity()) + " arguments but received " + std::to_string(arguments.size()) + " arguments."};
-      }
-
-      if(arguments[0].type() != typeid(double)){
-        throw BleachRuntimeError{functionName, "Argument of the 'std::math::sqrt' function must be a number."};
-      }
-
-      double radicand = std::any_cast<double>(arguments[0]);
-      if(radicand < 0){
-        throw BleachRuntimeError{functionName, "Argument of the 'std::math::sqrt' function cannot be a negative number."};
-      }
-
-      return std::sqrt(radicand);
-    }
-
-    std::string toString() override{
-      return "<native function: std::math::sqrt>";
-    }
-};
+  return std::sqrt(radicand);
+}
 
 // std::random::random
-class NativeRandom : public BleachCallable{
-  public:
-    int arity() override{
-      return 2;
-    }
+inline double nativeRandom(double left, double right){
+  if(left > right){
+    throw NativeFunctionError{"The first argument cannot be larger than the second argument."};
+  }
 
-    std::any call(Interpreter& interpreter, std::vector<std::any> arguments) override{
-      std::cout << "No implementation of this method available for the 'NativeRandom' class." << std::endl;
-      
-      return {};
-    }
-
-    std::any call(Interpreter& interpreter, Token paren, std::vector<std::any> arguments) override{
-      Token functionName{TokenType::IDENTIFIER, "std::random::random", this->toString(), paren.line};
-      if(arguments.size() != 2){
-        throw BleachRuntimeError{functionName, "Invalid number of arguments. Expected " + std::to_string(arity()) + " arguments but received " + std::to_string(arguments.size()) + " arguments."};
-      }
-
-      if(arguments[0].type() != typeid(double) || arguments[1].type() != typeid(double)){
-        throw BleachRuntimeError{functionName, "The two arguments of the 'std::random::random' function must be numbers."};
-      }
+  unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<> distribution(std::fmin(left, right), std::fmax(left, right));
 
-      double left = std::any_cast<double>(arguments[0]);
-      double right = std::any_cast<double>(arguments[1]);
-
-      if(left > right){
-        throw BleachRuntimeError{functionName, "The first argument cannot be larger than the second argument."};
-      }
-
-      unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
-
-      std::mt19937 gen(seed);
-      std::uniform_real_distribution<> distribution(std::fmin(left, right), std::fmax(left, right));
-
-      double randomNumber = distribution(gen);
-
-      return randomNumber;
-    }
-
-    std::string toString() override{
-      return "<native function: std::random::random>";
-    }  
-};
+  return distribution(gen);
+}
 
 // std::utils::ord
-class NativeOrd : public BleachCallable{
-  public:
-    int arity() override{
-      return 1;
-    }
-
-    std::any call(Interpreter& interpreter, std::vector<std::any> arguments) override{
-      std::cout << "No implementation of this method available for the 'NativeOrd' class." << std::endl;
-      
-      return {};
-    }
-
-   std::any call(Interpreter& interpreter, Token paren, std::vector<std::any> arguments) override{
-      Token functionName{TokenType::IDENTIFIER, "std::utils::ord", this->toString(), paren.line};
-      if(arguments.size() != 1){
-        throw BleachRuntimeError{functionName, "Invalid number of arguments. Expected " + std::to_string(arity()) + " arguments but received " + std::to_string(arguments.size()) + " arguments."};
-      }
-
-      if(arguments[0].type() != typeid(std::string)){
-        throw BleachRuntimeError{functionName, "Argument of the 'std::utils::ord' function must be a string."};
-      }
-
-      std::string str = std::any_cast<std::string>(arguments[0]);
-      if(str.length() != 1){
-        throw BleachRuntimeError{functionName, "Argument of the 'std::utils::ord' function cannot be a string of length different than 1."};
-      }
-
-      return static_cast<double>(static_cast<int>(str[0]));
-    }
+inline double nativeOrd(const std::string& str){
+  if(str.length() != 1){
+    throw NativeFunctionError{"Argument of the 'std::utils::ord' function cannot be a string of length different than 1."};
+  }
 
-    std::string toString() override{
-      return "<native function: std::utils::ord>";
-    }
-};
+  return static_cast<double>(static_cast<int>(str[0]));
+}
 
 // std::utils::strToNum
-class NativeStringToNumber : public BleachCallable{
-  public:
-    int arity() override{
-      return 1;
-    }
-
-    std::any call(Interpreter& interpreter, std::vector<std::any> arguments) override{
-      std::cout << "No implementation of this method available for the 'NativeStringToNumber' class." << std::endl;
-      
-      return {};
-    }
-
-   std::any call(Interpreter& interpreter, Token paren, std::vector<std::any> arguments) override{
-      Token functionName{TokenType::IDENTIFIER, "std::utils::strToNum", this->toString(), paren.line};
-      if(arguments.size() != 1){
-        throw BleachRuntimeError{functionName, "Invalid number of arguments. Expected " + std::to_string(arity()) + " arguments but received " + std::to_string(arguments.size()) + " arguments."};
-      }
-
-      if(arguments[0].type() != typeid(std::string)){
-        throw BleachRuntimeError{functionName, "Argument of the 'std::utils::strToNum' function must be a string."};
-      }
-
-      std::string str = std::any_cast<std::string>(arguments[0]);
-      double answer;
-
-      try{
-        answer = std::stod(str);
-      }catch(const std::invalid_argument& e){
-        throw BleachRuntimeError{functionName, "Argument of the 'std::utils::strToNum' function could not be converted to a number."};
-      }catch(const std::out_of_range& e){
-        throw BleachRuntimeError{functionName, "Argument of the 'std::utils::strToNum' function overflowed the range of the 'num' type."};
-      }
-
-      return answer;
-    }
-
-    std::string toString() override{
-      return "<native function: std::utils::strToNum>";
-    }
-};
+inline double nativeStringToNumber(const std::string& str){
+  try{
+    return std::stod(str);
+  }catch(const std::invalid_argument& e){
+    throw NativeFunctionError{"Argument of the 'std::utils::strToNum' function could not be converted to a number."};
+  }catch(const std::out_of_range& e){
+    throw NativeFunctionError{"Argument of the 'std::utils::strToNum' function overflowed the range of the 'num' type."};
+  }
+}
 
 // std::utils::strToBool
-class NativeStringToBool : public BleachCallable{
-  public:
-    int arity() override{
-      return 1;
-    }
+inline bool nativeStringToBool(const std::string& str){
+  if(str == "true"){
+    return true;
+  }else if(str == "false"){
+    return false;
+  }
 
-    std::any call(Interpreter& interpreter, std::vector<std::any> arguments) override{
-      std::cout << "No implementation of this method available for the 'NativeStringToBool' class." << std::endl;
-      
-      return {};
-    }
-
-   std::any call(Interpreter& interpreter, Token paren, std::vector<std::any> arguments) override{
-      Token functionName{TokenType::IDENTIFIER, "std::utils::strToBool", this->toString(), paren.line};
-      if(arguments.size() != 1){
-        throw BleachRuntimeError{functionName, "Invalid number of arguments. Expected " + std::to_string(arity()) + " arguments but received " + std::to_string(arguments.size()) + " arguments."};
-      }
-
-      if(arguments[0].type() != typeid(std::string)){
-        throw BleachRuntimeError{functionName, "Argument of the 'std::utils::strToBool' function must be a number."};
-      }
-
-      std::string str = std::any_cast<std::string>(arguments[0]);
-      if(str == "true"){
-        return true;
-      }else if(str == "false"){
-        return false;
-      }
-
-      throw BleachRuntimeError{functionName, "Could not convert the string value: " + str + " to a bool value."};
-    }
-
-    std::string toString() override{
-      return "<native function: std::utils::strToBool>";
-    }
-};
+  throw NativeFunctionError{"Could not convert the string value: " + str + " to a bool value."};
+}
 
 // std::utils::strToNil
-class NativeStringToNil : public BleachCallable{
-  public:
-    int arity() override{
-      return 1;
-    }
-
-    std::any call(Interpreter& interpreter, std::vector<std::any> arguments) override{
-      std::cout << "No implementation of this method available for the 'NativeStringToNil' class." << std::endl;
-      
-      return {};
-    }
-
-   std::any call(Interpreter& interpreter, Token paren, std::vector<std::any> arguments) override{
-      Token functionName{TokenType::IDENTIFIER, "std::utils::strToNil", this->toString(), paren.line};
-      if(arguments.size() != 1){
-        throw BleachRuntimeError{functionName, "Invalid number of arguments. Expected " + std::to_string(arity()) + " arguments but received " + std::to_string(arguments.size()) + " arguments."};
-      }
-
-      if(arguments[0].type() != typeid(std::string)){
-        throw BleachRuntimeError{functionName, "Argument of the 'std::utils::strToNil' function must be a number."};
-      }
-
-      std::string str = std::any_cast<std::string>(arguments[0]);
-      if(str == "nil"){
-        return nullptr;
-      }
+inline std::nullptr_t nativeStringToNil(const std::string& str){
+  if(str == "nil"){
+    return nullptr;
+  }
 
-      throw BleachRuntimeError{functionName, "Could not convert the string value: " + str + " to the nil value."};
-    }
+  throw NativeFunctionError{"Could not convert the string value: " + str + " to the nil value."};
+}
 
-    std::string toString() override{
-      return "<native function: std::utils::strToNil>";
-    }
-};
+// Native functions that are written by hand, since they expect a variable number of arguments or need access
+// to the internals of the Interpreter class.
 
 // std::io::print
 // I will need to implement a more robust version of this class. It must also be able to deal with the following
 // types: BleachList, BleachDict, BleachInstance.
-class NativePrint : public BleachCallable{
+class NativePrint : public BleachNativeFunction{
   public:
-    int arity() override{
-      return -1; // This means that the native function expects a variable number of arguments.
-    }
+    NativePrint()
+      : BleachNativeFunction{"std::io::print", -1} // This means that the native function expects a variable number of arguments.
+    {}
 
     std::string formatDouble(double value){
         std::ostringstream out;
@@ -649,7 +226,7 @@ class NativePrint : public BleachCallable{
         return out.str();
     }
 
-    std::string printValue(Interpreter& interpreter, Token functionName, std::any object, bool isInsideList=false){
+    std::string printValue(Interpreter& interpreter, const Token& functionName, const std::any& object, bool isInsideList=false){
       if(object.type() == typeid(nullptr)){
         return "nil";
       }
@@ -678,7 +255,7 @@ class NativePrint : public BleachCallable{
       if(object.type() == typeid(std::shared_ptr<BleachLambdaFunction>)){
         return std::any_cast<std::shared_ptr<BleachLambdaFunction>>(object)->toString();
       }
-      if(object.type() == typeid(std::shared_ptr<std::vector<std::any>>)){  
+      if(object.type() == typeid(std::shared_ptr<std::vector<std::any>>)){
         std::shared_ptr<std::vector<std::any>> vecPtr = std::any_cast<std::shared_ptr<std::vector<std::any>>>(object);
         std::string listAsString = "[";
 
@@ -695,64 +272,230 @@ class NativePrint : public BleachCallable{
 
         return listAsString;
       }
-      if(object.type() == typeid(std::shared_ptr<NativeClock>)){
-        return std::any_cast<std::shared_ptr<NativeClock>>(object)->toString();
-      }
-      if(object.type() == typeid(std::shared_ptr<NativeReadLine>)){
-        return std::any_cast<std::shared_ptr<NativeReadLine>>(object)->toString();
-      }
-      if(object.type() == typeid(std::shared_ptr<NativePrint>)){
-        return std::any_cast<std::shared_ptr<NativePrint>>(object)->toString();
-      }
-      if(object.type() == typeid(std::shared_ptr<NativeFileRead>)){
-        return std::any_cast<std::shared_ptr<NativeFileRead>>(object)->toString();
-      }
-      if(object.type() == typeid(std::shared_ptr<NativeFileWrite>)){
-        return std::any_cast<std::shared_ptr<NativeFileWrite>>(object)->toString();
-      }
-      if(object.type() == typeid(std::shared_ptr<NativeAbsoluteValue>)){
-        return std::any_cast<std::shared_ptr<NativeAbsoluteValue>>(object)->toString();
+      if(object.type() == typeid(std::shared_ptr<BleachNativeFunction>)){
+        return std::any_cast<const std::shared_ptr<BleachNativeFunction>&>(object)->toString();
       }
-      if(object.type() == typeid(std::shared_ptr<NativeLogarithm>)){
-        return std::any_cast<std::shared_ptr<NativeLogarithm>>(object)->toString();
+      if(object.type() == typeid(std::shared_ptr<BleachNativeObject>)){
+        return std::any_cast<const std::shared_ptr<BleachNativeObject>&>(object)->toString();
       }
-      if(object.type() == typeid(std::shared_ptr<NativeExponentiation>)){
-        return std::any_cast<std::shared_ptr<NativeExponentiation>>(object)->toString();
+
+      return "Error in stringify: object type not recognized.";
+    }
+
+    std::any invoke(Interpreter& interpreter, const Token& paren, ArgumentSpan arguments) override{
+      Token functionName = location(paren);
+      for(const std::any& argument : arguments){
+        *outputStream << printValue(interpreter, functionName, argument) << " ";
       }
-      if(object.type() == typeid(std::shared_ptr<NativeSquareRoot>)){
-        return std::any_cast<std::shared_ptr<NativeSquareRoot>>(object)->toString();
+
+      *outputStream << std::endl;
+
+      return nullptr;
+    }
+};
+
+// std::functools::memoize
+// The function returned by "std::functools::memoize". It keeps the values returned by the wrapped function in a
+// hash table keyed on its arguments. Only nil, booleans, numbers, strings and lists of such values (compared by
+// their contents) can be part of a key: Calls with any other argument (or with a list that contains itself) go
+// straight to the wrapped function. When the cache has a capacity, the least recently used entry is evicted to
+// make room for a new one.
+class MemoizedFunction : public BleachNativeFunction{
+  private:
+    using Entry = std::pair<std::string, std::any>; // The key (the encoded arguments) and the returned value.
+
+    const std::shared_ptr<BleachCallable> function;
+    const bool native; // Native functions are called through the overload of the "call" method that receives the closing parenthesis.
+    const std::size_t capacity; // 0 means that the cache is unbounded.
+    std::list<Entry> entries; // Ordered from the most recently used entry to the least recently used one.
+    std::unordered_map<std::string_view, std::list<Entry>::iterator> cache; // The keys point into the entries, which never move.
+
+    /**
+     * @brief Appends the encoding of an argument to the key of a call. Every value is prefixed by a tag, and
+     * strings and lists by their length, so different arguments never produce the same key.
+     *
+     * @param key: The key that is being built.
+     * @param value: The argument.
+     * @param lists: The lists that are being encoded (used to detect lists that contain themselves).
+     *
+     * @return A boolean that tells whether the argument can be part of a key.
+    **/
+    static bool appendKey(std::string& key, const std::any& value, std::vector<const std::vector<std::any>*>& lists){
+      if(value.type() == typeid(nullptr)){
+        key += 'n';
+      }else if(value.type() == typeid(bool)){
+        key += *std::any_cast<bool>(&value) ? 't' : 'f';
+      }else if(value.type() == typeid(double)){
+        double number = *std::any_cast<double>(&value);
+        if(number == 0){ // 0 and -0 are equal, so they must share the same key.
+          number = 0;
+        }
+        key += 'd';
+        key.append(reinterpret_cast<const char*>(&number), sizeof(number));
+      }else if(value.type() == typeid(std::string)){
+        const std::string& str = *std::any_cast<std::string>(&value);
+        std::size_t length = str.size();
+        key += 's';
+        key.append(reinterpret_cast<const char*>(&length), sizeof(length));
+        key += str;
+      }else if(value.type() == typeid(std::shared_ptr<std::vector<std::any>>)){
+        const std::vector<std::any>* list = std::any_cast<std::shared_ptr<std::vector<std::any>>>(&value)->get();
+        for(const std::vector<std::any>* outer : lists){
+          if(outer == list){
+            return false;
+          }
+        }
+        std::size_t length = list->size();
+        key += 'l';
+        key.append(reinterpret_cast<const char*>(&length), sizeof(length));
+        lists.push_back(list);
+        for(const std::any& element : *list){
+          if(!appendKey(key, element, lists)){
+            return false;
+          }
+        }
+        lists.pop_back();
+      }else{
+        return false;
       }
-      if(object.type() == typeid(std::shared_ptr<NativeRandom>)){
-        return std::any_cast<std::shared_ptr<NativeRandom>>(object)->toString();
+
+      return true;
+    }
+
+  public:
+    MemoizedFunction(std::shared_ptr<BleachCallable> function, std::size_t capacity)
+      : BleachNativeFunction{function->toString(), function->arity()}, function{std::move(function)}, native{dynamic_cast<BleachNativeFunction*>(this->function.get()) != nullptr}, capacity{capacity}
+    {}
+
+    std::any invoke(Interpreter& interpreter, const Token& paren, ArgumentSpan arguments) override{
+      checkArity(paren, arguments);
+
+      std::string key; // Built before the call, since the wrapped function may move its arguments away.
+      std::vector<const std::vector<std::any>*> lists;
+      for(const std::any& argument : arguments){
+        if(!appendKey(key, argument, lists)){
+          return native ? function->call(interpreter, paren, arguments) : function->call(interpreter, arguments);
+        }
       }
-      if(object.type() == typeid(std::shared_ptr<NativeOrd>)){
-        return std::any_cast<std::shared_ptr<NativeOrd>>(object)->toString();
+
+      auto hit = cache.find(key);
+      if(hit != cache.end()){
+        entries.splice(entries.begin(), entries, hit->second); // The entry becomes the most recently used one.
+        return hit->second->second;
       }
-      if(object.type() == typeid(std::shared_ptr<NativeStringToNumber>)){
-        return std::any_cast<std::shared_ptr<NativeStringToNumber>>(object)->toString();
+
+      std::any result = native ? function->call(interpreter, paren, arguments) : function->call(interpreter, arguments);
+
+      if(cache.find(key) == cache.end()){ // A recursive call with the same arguments may have already stored it.
+        entries.emplace_front(std::move(key), result);
+        cache.emplace(entries.front().first, entries.begin());
+        if(capacity != 0 && entries.size() > capacity){
+          cache.erase(entries.back().first);
+          entries.pop_back();
+        }
       }
 
-      return "Error in stringify: object type not recognized.";
+      return result;
     }
 
-    std::any call(Interpreter& interpreter, std::vector<std::any> arguments) override{
-      std::cout << "No implementation of this method available for the 'NativePrint' class." << std::endl;
-      
-      return {};
+    std::string toString() override{
+      return "<memoized " + name + ">";
     }
+};
 
-    std::any call(Interpreter& interpreter, Token paren, std::vector<std::any> arguments) override{
-      Token functionName{TokenType::IDENTIFIER, "std::io::print", toString(), paren.line};
-      for(std::any argument : arguments){
-        std::cout << printValue(interpreter, functionName, argument) << " ";
+class NativeMemoize : public BleachNativeFunction{
+  public:
+    NativeMemoize()
+      : BleachNativeFunction{"std::functools::memoize", -1} // Expects the function and, optionally, the capacity of the cache.
+    {}
+
+    std::any invoke(Interpreter& interpreter, const Token& paren, ArgumentSpan arguments) override{
+      if(arguments.size() != 1 && arguments.size() != 2){
+        throw BleachRuntimeError{location(paren), "Invalid number of arguments. Expected 1 or 2 arguments but received " + std::to_string(arguments.size()) + " arguments."};
+      }
+
+      std::shared_ptr<BleachCallable> function;
+      if(arguments[0].type() == typeid(std::shared_ptr<BleachFunction>)){
+        function = std::any_cast<std::shared_ptr<BleachFunction>>(arguments[0]);
+      }else if(arguments[0].type() == typeid(std::shared_ptr<BleachLambdaFunction>)){
+        function = std::any_cast<std::shared_ptr<BleachLambdaFunction>>(arguments[0]);
+      }else if(arguments[0].type() == typeid(std::shared_ptr<BleachNativeFunction>)){
+        function = std::any_cast<std::shared_ptr<BleachNativeFunction>>(arguments[0]);
+      }else{
+        throw BleachRuntimeError{location(paren), "The first argument of the 'std::functools::memoize' function must be a function, a lambda function or a native function."};
+      }
+
+      std::size_t capacity = 0;
+      if(arguments.size() == 2){
+        const double* number = std::any_cast<double>(&arguments[1]);
+        if(number == nullptr || *number < 1 || std::floor(*number) != *number){
+          throw BleachRuntimeError{location(paren), "The second argument (the maximum number of cached calls) of the 'std::functools::memoize' function must be a positive integer."};
+        }
+        capacity = static_cast<std::size_t>(*number);
       }
 
-      std::cout << std::endl;
-
-      return nullptr;
+      return std::shared_ptr<BleachNativeFunction>{std::make_shared<MemoizedFunction>(std::move(function), capacity)};
     }
+};
 
-    std::string toString() override{
-      return "<native function: std::io::print>";
-    } 
-};
\ No newline at end of file
+// std::utils::hash
+// Returns a number that is equal for equal values (see the "isEqual" method of the Interpreter class), so lists
+// and instances can be used as keys of a table written in Bleach.
+class NativeHash : public BleachNativeFunction{
+  public:
+    NativeHash()
+      : BleachNativeFunction{"std::utils::hash", 1}
+    {}
+
+    std::any invoke(Interpreter& interpreter, const Token& paren, ArgumentSpan arguments) override; // Defined inside the "Interpreter.hpp" file, since it needs the complete Interpreter class.
+};
+
+// std::runtime::snapshot
+class NativeSnapshot : public BleachNativeFunction{
+  public:
+    NativeSnapshot()
+      : BleachNativeFunction{"std::runtime::snapshot", 1}
+    {}
+
+    std::any invoke(Interpreter& interpreter, const Token& paren, ArgumentSpan arguments) override; // Defined inside the "Snapshot.cpp" file, since it needs the complete Interpreter class.
+};
+
+// std::serial::dump
+class NativeSerialDump : public BleachNativeFunction{
+  public:
+    NativeSerialDump()
+      : BleachNativeFunction{"std::serial::dump", 1}
+    {}
+
+    std::any invoke(Interpreter& interpreter, const Token& paren, ArgumentSpan arguments) override; // Defined inside the "Snapshot.cpp" file, since it needs the complete Interpreter class.
+};
+
+// std::serial::load
+class NativeSerialLoad : public BleachNativeFunction{
+  public:
+    NativeSerialLoad()
+      : BleachNativeFunction{"std::serial::load", 1}
+    {}
+
+    std::any invoke(Interpreter& interpreter, const Token& paren, ArgumentSpan arguments) override; // Defined inside the "Snapshot.cpp" file, since it needs the complete Interpreter class.
+};
+
+// std::serial::dumpFile
+class NativeSerialDumpFile : public BleachNativeFunction{
+  public:
+    NativeSerialDumpFile()
+      : BleachNativeFunction{"std::serial::dumpFile", 2}
+    {}
+
+    std::any invoke(Interpreter& interpreter, const Token& paren, ArgumentSpan arguments) override; // Defined inside the "Snapshot.cpp" file, since it needs the complete Interpreter class.
+};
+
+// std::serial::loadFile
+class NativeSerialLoadFile : public BleachNativeFunction{
+  public:
+    NativeSerialLoadFile()
+      : BleachNativeFunction{"std::serial::loadFile", 1}
+    {}
+
+    std::any invoke(Interpreter& interpreter, const Token& paren, ArgumentSpan arguments) override; // Defined inside the "Snapshot.cpp" file, since it needs the complete Interpreter class.
+};
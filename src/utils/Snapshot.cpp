@@ -0,0 +1,890 @@
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "./Snapshot.hpp"
+#include "../runner/Runner.hpp"
+
+
+static const char snapshotMagic[] = "BLEACHSNAP"; // The first bytes of every snapshot.
+static const char dataMagic[] = "BLEACHDATA"; // The first bytes of every value serialized by "std::serial::dump".
+static const std::uint32_t snapshotVersion = 2; // Incremented whenever the format of snapshots changes.
+static const std::uint32_t dataVersion = 1; // Incremented whenever the format of serialized values changes.
+
+/**
+ * @brief Constructs a MappedFile object, mapping the whole file into memory (read only). If that's not 
+ * possible, the "data" attribute is nullptr and the "error" attribute describes the problem.
+ *
+ * @param filePath: The path of the file.
+**/
+MappedFile::MappedFile(const std::string& filePath){
+  int file = open(filePath.c_str(), O_RDONLY);
+  struct stat status;
+  if(file < 0 || fstat(file, &status) < 0){
+    error = std::strerror(errno);
+    if(file >= 0){
+      close(file);
+    }
+    return;
+  }
+  if(status.st_size == 0){
+    error = "The file is empty.";
+    close(file);
+    return;
+  }
+
+  void* mapping = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+  close(file);
+  if(mapping == MAP_FAILED){
+    error = std::strerror(errno);
+    return;
+  }
+  data = static_cast<const char*>(mapping);
+  size = status.st_size;
+}
+
+/**
+ * @brief Destroys a MappedFile object, unmapping the file.
+**/
+MappedFile::~MappedFile(){
+  if(data != nullptr){
+    munmap(const_cast<char*>(data), size);
+  }
+}
+
+/**
+ * @brief Constructs a SnapshotWriter object.
+ *
+ * @param interpreter: The instance of the Interpreter class whose state will be stored.
+ * @param location: The token used to report runtime errors (the name of the native function that was called).
+ * @param portable: Whether classes are stored by name and functions are rejected (see the "writeData" method).
+**/
+SnapshotWriter::SnapshotWriter(Interpreter& interpreter, const Token& location, bool portable)
+  : interpreter{interpreter}, location{location}, portable{portable}
+{}
+
+SnapshotWriter::Nesting::Nesting(SnapshotWriter& writer)
+  : writer{writer}
+{
+  if(++writer.depth > maxSnapshotDepth){
+    writer.depth--;
+    throw BleachRuntimeError{writer.location, "The value is nested too deeply to be stored (more than " + std::to_string(maxSnapshotDepth) + " levels)."};
+  }
+}
+
+void SnapshotWriter::writeByte(std::uint8_t byte){
+  buffer.push_back(static_cast<char>(byte));
+
+  return;
+}
+
+void SnapshotWriter::writeInteger(std::uint32_t integer){
+  buffer.append(reinterpret_cast<const char*>(&integer), sizeof(integer));
+
+  return;
+}
+
+void SnapshotWriter::writeString(const std::string& string){
+  writeInteger(string.size());
+  buffer.append(string);
+
+  return;
+}
+
+/**
+ * @brief Stores a reference to an object that has already been stored. If the object is being stored for the
+ * first time, it's numbered instead.
+ *
+ * @param address: The address of the object.
+ *
+ * @return A boolean that tells whether a reference has been stored. If it's false, the caller must store the
+ * object itself.
+**/
+bool SnapshotWriter::writeReference(const void* address){
+  auto elem = references.find(address);
+  if(elem != references.end()){
+    writeByte(static_cast<std::uint8_t>(SnapshotTag::REFERENCE));
+    writeInteger(elem->second);
+    return true;
+  }
+
+  references.emplace(address, references.size());
+
+  return false;
+}
+
+/**
+ * @brief Stores an environment: Its bindings and, after them, its enclosing environment. The global environment
+ * is stored with the "GLOBALS" tag, and only the global variables that have been defined are stored.
+ *
+ * @param environment: The environment to be stored (it may be nullptr).
+ *
+ * @return Nothing (void).
+**/
+void SnapshotWriter::writeEnvironment(const std::shared_ptr<Environment>& environment){
+  Nesting nesting{*this};
+  if(environment == nullptr){
+    writeByte(static_cast<std::uint8_t>(SnapshotTag::NIL));
+    return;
+  }
+  if(writeReference(environment.get())){
+    return;
+  }
+
+  if(environment->enclosing == nullptr){
+    writeByte(static_cast<std::uint8_t>(SnapshotTag::GLOBALS));
+    writeInteger(environment->definedSlots());
+    for(const auto& [name, slot] : environment->slotIndices){
+      if(environment->slots[slot].has_value()){
+        writeString(name);
+        writeValue(environment->slots[slot]);
+      }
+    }
+    return;
+  }
+
+  writeByte(static_cast<std::uint8_t>(SnapshotTag::ENVIRONMENT));
+  writeInteger(environment->values.size());
+  for(const auto& [name, value] : environment->values){
+    writeString(name);
+    writeValue(value);
+  }
+  writeEnvironment(environment->enclosing);
+
+  return;
+}
+
+void SnapshotWriter::writeFunction(const std::shared_ptr<BleachFunction>& function){
+  if(writeReference(function.get())){
+    return;
+  }
+
+  writeByte(static_cast<std::uint8_t>(SnapshotTag::FUNCTION));
+  writeInteger(function->functionDeclaration->declarationId);
+  writeByte(function->isInitializer);
+  writeEnvironment(function->closure);
+
+  return;
+}
+
+/**
+ * @brief Stores a value, according to the format described by the SnapshotTag enum.
+ *
+ * @param value: The value to be stored.
+ *
+ * @return Nothing (void).
+ *
+ * @note: If the value cannot be stored (or it's nested too deeply), an instance of the BleachRuntimeError class 
+ * is thrown.
+**/
+void SnapshotWriter::writeValue(const std::any& value){
+  Nesting nesting{*this};
+  if(!value.has_value()){
+    writeByte(static_cast<std::uint8_t>(SnapshotTag::EMPTY));
+  }else if(value.type() == typeid(nullptr)){
+    writeByte(static_cast<std::uint8_t>(SnapshotTag::NIL));
+  }else if(value.type() == typeid(bool)){
+    writeByte(static_cast<std::uint8_t>(std::any_cast<bool>(value) ? SnapshotTag::TRUE : SnapshotTag::FALSE));
+  }else if(value.type() == typeid(double)){
+    double number = std::any_cast<double>(value);
+    writeByte(static_cast<std::uint8_t>(SnapshotTag::NUMBER));
+    buffer.append(reinterpret_cast<const char*>(&number), sizeof(number));
+  }else if(value.type() == typeid(std::string)){
+    writeByte(static_cast<std::uint8_t>(SnapshotTag::STRING));
+    writeString(std::any_cast<const std::string&>(value));
+  }else if(value.type() == typeid(std::shared_ptr<std::vector<std::any>>)){
+    const auto& list = std::any_cast<const std::shared_ptr<std::vector<std::any>>&>(value);
+    if(writeReference(list.get())){
+      return;
+    }
+    writeByte(static_cast<std::uint8_t>(SnapshotTag::LIST));
+    writeInteger(list->size());
+    for(const std::any& element : *list){
+      writeValue(element);
+    }
+  }else if(value.type() == typeid(std::shared_ptr<BleachInstance>)){
+    const auto& instance = std::any_cast<const std::shared_ptr<BleachInstance>&>(value);
+    if(writeReference(instance.get())){
+      return;
+    }
+    writeByte(static_cast<std::uint8_t>(SnapshotTag::INSTANCE));
+    writeValue(std::any{instance->klass});
+    if(portable){ // The class may have another layout inside the program that loads the value, so every field is stored by name.
+      writeInteger(0);
+      std::size_t fieldCount = instance->fields.size();
+      for(const std::any& slot : instance->slots){
+        fieldCount += slot.has_value();
+      }
+      writeInteger(fieldCount);
+      for(const auto& [fieldId, slot] : instance->klass->fieldSlots){
+        if(instance->slots[slot].has_value()){
+          writeString(SymbolTable::name(fieldId));
+          writeValue(instance->slots[slot]);
+        }
+      }
+    }else{
+      writeInteger(instance->slots.size());
+      for(const std::any& slot : instance->slots){
+        writeValue(slot);
+      }
+      writeInteger(instance->fields.size());
+    }
+    for(const auto& [fieldId, field] : instance->fields){
+      writeString(SymbolTable::name(fieldId));
+      writeValue(field);
+    }
+  }else if(value.type() == typeid(std::shared_ptr<BleachClass>)){
+    const auto& klass = std::any_cast<const std::shared_ptr<BleachClass>&>(value);
+    if(writeReference(klass.get())){
+      return;
+    }
+    if(portable){
+      writeByte(static_cast<std::uint8_t>(SnapshotTag::CLASS_NAME));
+      writeString(klass->name);
+      return;
+    }
+    writeByte(static_cast<std::uint8_t>(SnapshotTag::CLASS));
+    writeString(klass->name);
+    writeValue(klass->superclass == nullptr ? std::any{nullptr} : std::any{klass->superclass});
+    writeInteger(klass->methods.size());
+    for(const auto& [methodName, method] : klass->methods){
+      writeString(methodName);
+      writeFunction(method);
+    }
+    std::vector<std::string> fieldNames(klass->fieldCount);
+    for(const auto& [fieldId, slot] : klass->fieldSlots){
+      fieldNames[slot] = SymbolTable::name(fieldId);
+    }
+    writeInteger(fieldNames.size());
+    for(const std::string& fieldName : fieldNames){
+      writeString(fieldName);
+    }
+  }else if(portable && (value.type() == typeid(std::shared_ptr<BleachFunction>) || value.type() == typeid(std::shared_ptr<BleachLambdaFunction>))){
+    throw BleachRuntimeError{location, "Functions cannot be serialized, only nil, booleans, numbers, strings, lists and instances."};
+  }else if(value.type() == typeid(std::shared_ptr<BleachFunction>)){
+    writeFunction(std::any_cast<const std::shared_ptr<BleachFunction>&>(value));
+  }else if(value.type() == typeid(std::shared_ptr<BleachLambdaFunction>)){
+    const auto& lambda = std::any_cast<const std::shared_ptr<BleachLambdaFunction>&>(value);
+    if(writeReference(lambda.get())){
+      return;
+    }
+    writeByte(static_cast<std::uint8_t>(SnapshotTag::LAMBDA));
+    writeInteger(lambda->lambdaFunctionDeclaration->declarationId);
+    writeEnvironment(lambda->closure);
+  }else{
+    if(portable){
+      throw BleachRuntimeError{location, "Only nil, booleans, numbers, strings, lists and instances can be serialized."};
+    }
+    // The native functions of the standard library are created by the constructor of the Interpreter class (and
+    // the ones of native modules when the module is imported), so they can be identified by the global variable
+    // that holds them. Foreign functions (see the ForeignFunction class) are not held by any of them.
+    if(value.type() == typeid(std::shared_ptr<BleachNativeFunction>)){
+      const auto& native = std::any_cast<const std::shared_ptr<BleachNativeFunction>&>(value);
+      auto elem = interpreter.globals->slotIndices.find(native->getName());
+      const std::any* global = elem != interpreter.globals->slotIndices.end() ? &interpreter.globals->slots[elem->second] : nullptr;
+      if(global != nullptr && global->type() == value.type() && std::any_cast<const std::shared_ptr<BleachNativeFunction>&>(*global) == native){
+        writeByte(static_cast<std::uint8_t>(SnapshotTag::NATIVE));
+        writeString(native->getName());
+        return;
+      }
+    }
+    throw BleachRuntimeError{location, "Methods of lists and strings, native objects (e.g. foreign libraries), foreign functions and memoized functions cannot be stored inside a snapshot."};
+  }
+
+  return;
+}
+
+/**
+ * @brief Stores the whole state of the interpreter into a snapshot.
+ *
+ * @return A string that contains the bytes of the snapshot.
+**/
+std::string SnapshotWriter::write(){
+  buffer.append(snapshotMagic, sizeof(snapshotMagic));
+  writeInteger(snapshotVersion);
+  writeInteger(interpreter.nativeModules.size());
+  for(const std::string& path : interpreter.nativeModules){
+    writeString(path);
+  }
+  writeInteger(interpreter.sources.size());
+  for(const std::string& source : interpreter.sources){
+    writeString(source);
+  }
+  writeInteger(interpreter.declarationCount);
+  writeEnvironment(interpreter.globals);
+
+  return std::move(buffer);
+}
+
+/**
+ * @brief Serializes a single value (and every value reachable from it), as done by "std::serial::dump".
+ *
+ * @param value: The value to be serialized.
+ *
+ * @return A string that contains the bytes of the serialized value.
+**/
+std::string SnapshotWriter::writeData(const std::any& value){
+  buffer.append(dataMagic, sizeof(dataMagic));
+  writeInteger(dataVersion);
+  writeValue(value);
+
+  return std::move(buffer);
+}
+
+/**
+ * @brief Constructs a SnapshotReader object.
+ *
+ * @param interpreter: A fresh instance of the Interpreter class, into which snapshots are restored.
+**/
+SnapshotReader::SnapshotReader(Interpreter& interpreter)
+  : interpreter{interpreter}
+{}
+
+std::uint8_t SnapshotReader::readByte(){
+  if(current >= end){
+    throw std::runtime_error{"The snapshot is truncated."};
+  }
+
+  return static_cast<std::uint8_t>(*current++);
+}
+
+std::uint32_t SnapshotReader::readInteger(){
+  std::uint32_t integer;
+  if(end - current < sizeof(integer)){
+    throw std::runtime_error{"The snapshot is truncated."};
+  }
+  std::memcpy(&integer, current, sizeof(integer));
+  current += sizeof(integer);
+
+  return integer;
+}
+
+/**
+ * @brief Reads the number of items (elements, bindings, fields, ...) that follow. Every item takes at least one
+ * byte, so a number that is larger than the amount of bytes left is rejected before anything is allocated for
+ * such items.
+ *
+ * @return The number of items.
+**/
+std::uint32_t SnapshotReader::readCount(){
+  std::uint32_t count = readInteger();
+  if(end - current < count){
+    throw std::runtime_error{"The snapshot is truncated."};
+  }
+
+  return count;
+}
+
+std::string SnapshotReader::readString(){
+  std::uint32_t length = readInteger();
+  if(end - current < length){
+    throw std::runtime_error{"The snapshot is truncated."};
+  }
+  std::string string{current, length};
+  current += length;
+
+  return string;
+}
+
+std::any SnapshotReader::readDeclaration(std::uint32_t number){
+  auto elem = interpreter.restoredDeclarations.find(number);
+  if(elem == interpreter.restoredDeclarations.end()){
+    throw std::runtime_error{"The snapshot refers to an unknown function declaration."};
+  }
+
+  return elem->second;
+}
+
+/**
+ * @brief Rebuilds an environment. The environment is created (and numbered) before its bindings are read,
+ * since they may refer back to it (for instance, a function declared inside a block, stored in that block).
+ *
+ * @return The rebuilt environment (it may be nullptr).
+**/
+std::shared_ptr<Environment> SnapshotReader::readEnvironment(){
+  Nesting nesting{*this};
+  SnapshotTag tag = static_cast<SnapshotTag>(readByte());
+  if(tag == SnapshotTag::NIL){
+    return nullptr;
+  }
+  if(tag == SnapshotTag::REFERENCE){
+    std::uint32_t number = readInteger();
+    if(number >= references.size() || references[number].type() != typeid(std::shared_ptr<Environment>)){
+      throw std::runtime_error{"The snapshot has an invalid reference to an environment."};
+    }
+    return std::any_cast<std::shared_ptr<Environment>>(references[number]);
+  }
+
+  if(tag == SnapshotTag::GLOBALS){
+    std::shared_ptr<Environment>& globals = interpreter.globals;
+    references.emplace_back(globals);
+    std::uint32_t count = readCount();
+    globals->slots.reserve(globals->slots.size() + count); // The slots must not move while they are being filled.
+    for(std::uint32_t i = 0; i < count; i++){
+      int slot = globals->slotOf(readString());
+      readValue(globals->slots[slot]);
+    }
+    return globals;
+  }
+
+  if(tag != SnapshotTag::ENVIRONMENT){
+    throw std::runtime_error{"The snapshot has an invalid environment."};
+  }
+  std::shared_ptr<Environment> environment = std::make_shared<Environment>();
+  references.emplace_back(environment);
+  std::uint32_t count = readCount();
+  for(std::uint32_t i = 0; i < count; i++){
+    std::string name = readString();
+    readValue(environment->values[name]);
+  }
+  environment->enclosing = readEnvironment();
+  if(environment->enclosing == nullptr){
+    throw std::runtime_error{"The snapshot has an environment with no enclosing environment."};
+  }
+
+  return environment;
+}
+
+/**
+ * @brief Rebuilds a function (or returns a function that has already been rebuilt).
+ *
+ * @return The rebuilt function.
+**/
+std::shared_ptr<BleachFunction> SnapshotReader::readFunction(){
+  SnapshotTag tag = static_cast<SnapshotTag>(readByte());
+  if(tag == SnapshotTag::REFERENCE){
+    std::uint32_t number = readInteger();
+    if(number >= references.size() || references[number].type() != typeid(std::shared_ptr<BleachFunction>)){
+      throw std::runtime_error{"The snapshot has an invalid reference to a function."};
+    }
+    return std::any_cast<std::shared_ptr<BleachFunction>>(references[number]);
+  }
+  if(tag != SnapshotTag::FUNCTION){
+    throw std::runtime_error{"The snapshot has an invalid function."};
+  }
+
+  std::size_t number = references.size();
+  references.emplace_back();
+  std::any declaration = readDeclaration(readInteger());
+  if(declaration.type() != typeid(std::shared_ptr<Function>)){
+    throw std::runtime_error{"The snapshot refers to a declaration that is not a function."};
+  }
+  bool isInitializer = readByte();
+  std::shared_ptr<BleachFunction> function = std::make_shared<BleachFunction>(std::any_cast<std::shared_ptr<Function>>(declaration), nullptr, isInitializer);
+  references[number] = function;
+  function->closure = readEnvironment();
+
+  return function;
+}
+
+/**
+ * @brief Rebuilds a class. A class can only be built once its superclass and its methods have been rebuilt, so
+ * the places that refer to the class in the meantime are patched after the whole snapshot is read.
+ *
+ * @return The rebuilt class.
+**/
+std::shared_ptr<BleachClass> SnapshotReader::readClass(){
+  std::size_t number = references.size();
+  references.emplace_back();
+
+  std::string name = readString();
+  std::any superclass;
+  readValue(superclass);
+  if(superclass.type() != typeid(nullptr) && superclass.type() != typeid(std::shared_ptr<BleachClass>)){
+    throw std::runtime_error{"The snapshot has a class whose superclass is not a class."};
+  }
+
+  std::map<std::string, std::shared_ptr<BleachFunction>> methods;
+  std::uint32_t methodCount = readCount();
+  for(std::uint32_t i = 0; i < methodCount; i++){
+    std::string methodName = readString();
+    methods[methodName] = readFunction();
+  }
+
+  std::vector<int> fieldIds;
+  std::uint32_t fieldCount = readCount();
+  for(std::uint32_t i = 0; i < fieldCount; i++){
+    fieldIds.push_back(SymbolTable::intern(readString()));
+  }
+
+  std::shared_ptr<BleachClass> klass = std::make_shared<BleachClass>(name, superclass.type() == typeid(nullptr) ? nullptr : std::any_cast<std::shared_ptr<BleachClass>>(superclass), methods, fieldIds);
+  references[number] = klass;
+
+  return klass;
+}
+
+/**
+ * @brief Rebuilds a value and stores it inside the received destination.
+ *
+ * @param destination: The place where the value is stored. It must not move until the whole snapshot is read,
+ * since it may be patched later on (see the "readClass" method).
+ *
+ * @return Nothing (void).
+**/
+void SnapshotReader::readValue(std::any& destination){
+  Nesting nesting{*this};
+  SnapshotTag tag = static_cast<SnapshotTag>(readByte());
+  switch(tag){
+    case SnapshotTag::EMPTY:
+      destination.reset();
+      break;
+    case SnapshotTag::NIL:
+      destination = nullptr;
+      break;
+    case SnapshotTag::FALSE:
+    case SnapshotTag::TRUE:
+      destination = (tag == SnapshotTag::TRUE);
+      break;
+    case SnapshotTag::NUMBER:{
+      double number;
+      if(end - current < sizeof(number)){
+        throw std::runtime_error{"The snapshot is truncated."};
+      }
+      std::memcpy(&number, current, sizeof(number));
+      current += sizeof(number);
+      destination = number;
+      break;
+    }
+    case SnapshotTag::STRING:
+      destination = readString();
+      break;
+    case SnapshotTag::REFERENCE:{
+      std::uint32_t number = readInteger();
+      if(number >= references.size()){
+        throw std::runtime_error{"The snapshot has an invalid reference."};
+      }
+      if(references[number].has_value()){
+        destination = references[number];
+      }else{
+        pendingReferences.emplace_back(&destination, number); // The referred object is still being rebuilt.
+      }
+      break;
+    }
+    case SnapshotTag::LIST:{
+      std::shared_ptr<std::vector<std::any>> list = std::make_shared<std::vector<std::any>>(readCount());
+      references.emplace_back(list);
+      for(std::any& element : *list){
+        readValue(element);
+      }
+      destination = list;
+      break;
+    }
+    case SnapshotTag::INSTANCE:{
+      std::size_t number = references.size();
+      references.emplace_back();
+      std::any klass;
+      readValue(klass);
+      if(klass.type() != typeid(std::shared_ptr<BleachClass>)){
+        throw std::runtime_error{"The snapshot has an instance whose class is not available."};
+      }
+      std::shared_ptr<BleachInstance> instance = std::make_shared<BleachInstance>(std::any_cast<std::shared_ptr<BleachClass>>(klass));
+      references[number] = instance;
+      std::uint32_t slotCount = readInteger();
+      if(slotCount != 0 && slotCount != instance->slots.size()){
+        throw std::runtime_error{"The snapshot has an instance that does not match the layout of its class."};
+      }
+      for(std::uint32_t i = 0; i < slotCount; i++){
+        readValue(instance->slots[i]);
+      }
+      std::uint32_t fieldCount = readCount();
+      for(std::uint32_t i = 0; i < fieldCount; i++){
+        int fieldId = SymbolTable::intern(readString());
+        int slot = instance->klass->findFieldSlot(fieldId);
+        readValue(slot >= 0 ? instance->slots[slot] : instance->fields[fieldId]);
+      }
+      destination = instance;
+      break;
+    }
+    case SnapshotTag::CLASS:
+      destination = readClass();
+      break;
+    case SnapshotTag::FUNCTION:
+      current--; // The "readFunction" method reads the tag by itself.
+      destination = readFunction();
+      break;
+    case SnapshotTag::LAMBDA:{
+      std::size_t number = references.size();
+      references.emplace_back();
+      std::any declaration = readDeclaration(readInteger());
+      if(declaration.type() != typeid(std::shared_ptr<LambdaFunction>)){
+        throw std::runtime_error{"The snapshot refers to a declaration that is not a lambda function."};
+      }
+      std::shared_ptr<BleachLambdaFunction> lambda = std::make_shared<BleachLambdaFunction>(std::any_cast<std::shared_ptr<LambdaFunction>>(declaration), nullptr);
+      references[number] = lambda;
+      lambda->closure = readEnvironment();
+      destination = lambda;
+      break;
+    }
+    case SnapshotTag::CLASS_NAME:{
+      std::string name = readString();
+      auto elem = interpreter.globals->slotIndices.find(name);
+      if(elem == interpreter.globals->slotIndices.end() || interpreter.globals->slots[elem->second].type() != typeid(std::shared_ptr<BleachClass>)){
+        throw std::runtime_error{"The value refers to a class that is not defined: '" + name + "'."};
+      }
+      references.push_back(interpreter.globals->slots[elem->second]);
+      destination = references.back();
+      break;
+    }
+    case SnapshotTag::NATIVE:{
+      std::string name = readString();
+      auto elem = interpreter.globals->slotIndices.find(name);
+      if(elem == interpreter.globals->slotIndices.end() || !interpreter.globals->slots[elem->second].has_value()){
+        throw std::runtime_error{"The snapshot refers to an unknown native function: '" + name + "'."};
+      }
+      destination = interpreter.globals->slots[elem->second];
+      break;
+    }
+    default:
+      throw std::runtime_error{"The snapshot has an invalid value."};
+  }
+
+  return;
+}
+
+/**
+ * @brief Restores a snapshot file into the interpreter.
+ *
+ * This method is responsible for mapping the snapshot file into memory, importing the native modules that were
+ * imported by the program, resolving (without running) the sources stored inside it, so every function declaration gets its number back, and rebuilding the global
+ * environment. If something goes wrong, the problem is reported to the error stream.
+ *
+ * @param filePath: The path of the snapshot file.
+ *
+ * @return A boolean that tells whether the snapshot has been restored.
+**/
+bool SnapshotReader::restore(const std::string& filePath){
+  MappedFile file{filePath};
+  if(file.data == nullptr){
+    *errorStream << RED << "[BLEACH Interpreter Error]: Failed to map the snapshot '" << filePath << "' into memory: " << file.error << WHITE << std::endl;
+    return false;
+  }
+  current = file.data;
+  end = file.data + file.size;
+
+  bool restored = true;
+  try{
+    if(end - current < sizeof(snapshotMagic) || std::memcmp(current, snapshotMagic, sizeof(snapshotMagic)) != 0){
+      throw std::runtime_error{"The file is not a Bleach snapshot."};
+    }
+    current += sizeof(snapshotMagic);
+    if(readInteger() != snapshotVersion){
+      throw std::runtime_error{"The snapshot was taken by an incompatible version of the BLEACH Interpreter."};
+    }
+
+    std::uint32_t moduleCount = readCount(); // The native modules are imported again, so the native functions they define can be found by name.
+    for(std::uint32_t i = 0; i < moduleCount; i++){
+      interpreter.importNativeModule(readString());
+    }
+
+    interpreter.restoringSnapshot = true;
+    std::uint32_t sourceCount = readCount();
+    for(std::uint32_t i = 0; i < sourceCount; i++){
+      compileSource(interpreter, readString());
+      if(hadError){
+        throw std::runtime_error{"The sources stored inside the snapshot could not be resolved."};
+      }
+    }
+    interpreter.restoringSnapshot = false;
+    if(readInteger() != interpreter.declarationCount){
+      throw std::runtime_error{"The functions stored inside the snapshot do not match its sources."};
+    }
+
+    readEnvironment();
+    for(auto& [destination, number] : pendingReferences){
+      *destination = references[number];
+    }
+  }catch(const std::exception& exception){
+    *errorStream << RED << "[BLEACH Interpreter Error]: Failed to restore the snapshot '" << filePath << "': " << exception.what() << WHITE << std::endl;
+    restored = false;
+  }
+
+  interpreter.restoringSnapshot = false;
+  interpreter.restoredDeclarations.clear();
+  references.clear();
+  pendingReferences.clear();
+
+  return restored;
+}
+
+/**
+ * @brief Loads a single value serialized by the "writeData" method of the SnapshotWriter class.
+ *
+ * @param begin: The first byte of the serialized value.
+ * @param end: The byte that follows the last byte of the serialized value.
+ *
+ * @return The loaded value.
+ *
+ * @note: If the bytes are not a valid serialized value, an instance of std::runtime_error is thrown.
+**/
+std::any SnapshotReader::readData(const char* begin, const char* end){
+  current = begin;
+  this->end = end;
+  if(end - current < sizeof(dataMagic) || std::memcmp(current, dataMagic, sizeof(dataMagic)) != 0){
+    throw std::runtime_error{"The bytes are not a value serialized by 'std::serial::dump'."};
+  }
+  current += sizeof(dataMagic);
+  if(readInteger() != dataVersion){
+    throw std::runtime_error{"The value was serialized by an incompatible version of the BLEACH Interpreter."};
+  }
+
+  std::any value;
+  try{
+    readValue(value);
+  }catch(const std::bad_alloc&){
+    references.clear();
+    pendingReferences.clear();
+    throw std::runtime_error{"The value is too large to be loaded."};
+  }catch(...){
+    references.clear();
+    pendingReferences.clear();
+    throw;
+  }
+  for(auto& [destination, number] : pendingReferences){
+    *destination = references[number];
+  }
+  references.clear();
+  pendingReferences.clear();
+
+  return value;
+}
+
+/**
+ * @brief Implements the "std::runtime::snapshot" native function: Stores the whole state of the interpreter
+ * (see the SnapshotWriter class) inside the file whose path is received as its only argument. Such file can be
+ * restored later on through the "--restore" option of the BLEACH Interpreter.
+ *
+ * @param interpreter: The instance of the Interpreter class whose state is stored.
+ * @param paren: The token that represents the closing parenthesis of the call.
+ * @param arguments: The list of arguments of the call.
+ *
+ * @return nil.
+**/
+std::any NativeSnapshot::invoke(Interpreter& interpreter, const Token& paren, ArgumentSpan arguments){
+  Token functionName = location(paren);
+  checkArity(paren, arguments);
+  if(arguments[0].type() != typeid(std::string)){
+    throw BleachRuntimeError{functionName, "The argument of the 'std::runtime::snapshot' function must be a string (the path of the snapshot file)."};
+  }
+
+  std::string filePath = std::any_cast<std::string>(arguments[0]);
+  SnapshotWriter writer{interpreter, functionName};
+  std::string snapshot = writer.write();
+
+  std::ofstream file{filePath, std::ios::out | std::ios::binary | std::ios::trunc};
+  if(!file || !file.write(snapshot.data(), snapshot.size())){
+    throw BleachRuntimeError{functionName, "Could not write the snapshot to the provided file: '" + filePath + "'."};
+  }
+
+  return nullptr;
+}
+
+/**
+ * @brief Implements the "std::serial::dump" native function: Serializes its only argument (nil, a boolean, a 
+ * number, a string, a list or an instance, and every value reachable from it) into a compact binary encoding 
+ * (see the "writeData" method of the SnapshotWriter class).
+ *
+ * @param interpreter: The instance of the Interpreter class that runs the program.
+ * @param paren: The token that represents the closing parenthesis of the call.
+ * @param arguments: The list of arguments of the call.
+ *
+ * @return A string that contains the bytes of the serialized value.
+**/
+std::any NativeSerialDump::invoke(Interpreter& interpreter, const Token& paren, ArgumentSpan arguments){
+  Token functionName = location(paren);
+  checkArity(paren, arguments);
+
+  SnapshotWriter writer{interpreter, functionName, true};
+
+  return writer.writeData(arguments[0]);
+}
+
+/**
+ * @brief Implements the "std::serial::load" native function: Loads a value from the string returned by the
+ * "std::serial::dump" native function. Instances are rebuilt with the global class of the same name.
+ *
+ * @param interpreter: The instance of the Interpreter class that runs the program.
+ * @param paren: The token that represents the closing parenthesis of the call.
+ * @param arguments: The list of arguments of the call.
+ *
+ * @return The loaded value.
+**/
+std::any NativeSerialLoad::invoke(Interpreter& interpreter, const Token& paren, ArgumentSpan arguments){
+  Token functionName = location(paren);
+  checkArity(paren, arguments);
+  if(arguments[0].type() != typeid(std::string)){
+    throw BleachRuntimeError{functionName, "The argument of the 'std::serial::load' function must be a string returned by the 'std::serial::dump' function."};
+  }
+
+  const std::string& bytes = std::any_cast<const std::string&>(arguments[0]);
+  try{
+    SnapshotReader reader{interpreter};
+    return reader.readData(bytes.data(), bytes.data() + bytes.size());
+  }catch(const std::runtime_error& error){
+    throw BleachRuntimeError{functionName, error.what()};
+  }
+}
+
+/**
+ * @brief Implements the "std::serial::dumpFile" native function: Serializes its second argument (as done by the
+ * "std::serial::dump" native function) into the file whose path is its first argument.
+ *
+ * @param interpreter: The instance of the Interpreter class that runs the program.
+ * @param paren: The token that represents the closing parenthesis of the call.
+ * @param arguments: The list of arguments of the call.
+ *
+ * @return nil.
+**/
+std::any NativeSerialDumpFile::invoke(Interpreter& interpreter, const Token& paren, ArgumentSpan arguments){
+  Token functionName = location(paren);
+  checkArity(paren, arguments);
+  if(arguments[0].type() != typeid(std::string)){
+    throw BleachRuntimeError{functionName, "The first argument of the 'std::serial::dumpFile' function must be a string (the path of the file)."};
+  }
+
+  std::string filePath = std::any_cast<std::string>(arguments[0]);
+  SnapshotWriter writer{interpreter, functionName, true};
+  std::string bytes = writer.writeData(arguments[1]);
+
+  std::ofstream file{filePath, std::ios::out | std::ios::binary | std::ios::trunc};
+  if(!file || !file.write(bytes.data(), bytes.size())){
+    throw BleachRuntimeError{functionName, "Could not write the serialized value to the provided file: '" + filePath + "'."};
+  }
+
+  return nullptr;
+}
+
+/**
+ * @brief Implements the "std::serial::loadFile" native function: Loads a value from a file written by the
+ * "std::serial::dumpFile" native function. The file is mapped into memory and the value is rebuilt straight
+ * from the mapped bytes.
+ *
+ * @param interpreter: The instance of the Interpreter class that runs the program.
+ * @param paren: The token that represents the closing parenthesis of the call.
+ * @param arguments: The list of arguments of the call.
+ *
+ * @return The loaded value.
+**/
+std::any NativeSerialLoadFile::invoke(Interpreter& interpreter, const Token& paren, ArgumentSpan arguments){
+  Token functionName = location(paren);
+  checkArity(paren, arguments);
+  if(arguments[0].type() != typeid(std::string)){
+    throw BleachRuntimeError{functionName, "The argument of the 'std::serial::loadFile' function must be a string (the path of the file)."};
+  }
+
+  std::string filePath = std::any_cast<std::string>(arguments[0]);
+  MappedFile file{filePath};
+  if(file.data == nullptr){
+    throw BleachRuntimeError{functionName, "Could not read the provided file: '" + filePath + "': " + file.error};
+  }
+  try{
+    SnapshotReader reader{interpreter};
+    return reader.readData(file.data, file.data + file.size);
+  }catch(const std::runtime_error& error){
+    throw BleachRuntimeError{functionName, error.what()};
+  }
+}
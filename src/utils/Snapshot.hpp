@@ -0,0 +1,185 @@
+#pragma once
+
+#include <any>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "./Token.hpp"
+
+
+class BleachClass; // Forward declaration necessary to implement the SnapshotWriter and SnapshotReader classes.
+class BleachFunction; // Forward declaration necessary to implement the SnapshotWriter and SnapshotReader classes.
+class Environment; // Forward declaration necessary to implement the SnapshotWriter and SnapshotReader classes.
+class Interpreter; // Forward declaration necessary to implement the SnapshotWriter and SnapshotReader classes.
+
+inline constexpr unsigned int maxSnapshotDepth = 4096; // Values nested more deeply are neither stored nor rebuilt, so neither can exhaust the stack of the interpreter.
+
+/**
+ * @enum SnapshotTag
+ *
+ * @brief Enumerates the tags of the binary format of snapshots. Every value stored inside a snapshot starts with
+ * one of these tags (a single byte).
+ *
+ * Lists, instances, classes, functions, lambda functions and environments are numbered in the order in which
+ * they show up inside the snapshot. When one of them shows up again, only the "REFERENCE" tag and its number are
+ * stored, so shared references (and cycles) are preserved.
+**/
+enum class SnapshotTag : std::uint8_t{
+  EMPTY, // A slot or field that has not been assigned yet.
+  NIL,
+  FALSE,
+  TRUE,
+  NUMBER, // Followed by the 8 bytes of a double.
+  STRING, // Followed by its length (4 bytes) and its bytes.
+  REFERENCE, // Followed by the number (4 bytes) of a value that has already been stored.
+  LIST, // Followed by its length and its elements.
+  INSTANCE, // Followed by its class, its slots and its other fields (by name). Portable values store every field by name.
+  CLASS, // Followed by its name, its superclass, its methods and the names of the fields of its layout.
+  FUNCTION, // Followed by the number of its declaration, whether it's an initializer and its closure.
+  LAMBDA, // Followed by the number of its declaration and its closure.
+  NATIVE, // Followed by the name of the global variable that holds the native function.
+  ENVIRONMENT, // Followed by its bindings and its enclosing environment.
+  GLOBALS, // Followed by the bindings of the global environment.
+  CLASS_NAME, // Followed by the name of a global class. Used instead of "CLASS" by values serialized with "std::serial".
+};
+
+/**
+ * @struct MappedFile
+ *
+ * @brief Maps a whole file into memory (read only) for as long as the object lives. Snapshots and serialized
+ * values are read straight from the mapped bytes.
+**/
+struct MappedFile{
+  const char* data = nullptr; // The bytes of the file (nullptr if it could not be mapped).
+  std::size_t size = 0; // The size of the file.
+  std::string error; // The reason why the file could not be mapped.
+
+  MappedFile(const std::string& filePath);
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  ~MappedFile();
+};
+
+/**
+ * @class SnapshotWriter
+ *
+ * @brief Utility class that serializes the state of an instance of the Interpreter class into a snapshot.
+ *
+ * The SnapshotWriter class is responsible for storing, in a compact binary format, the global environment of
+ * an instance of the Interpreter class and every value that can be reached from it (lists, instances, classes,
+ * functions, lambda functions and the environments that functions have captured). Functions are not stored as
+ * ASTs: A snapshot stores the source code of every program that has declared a function (see the "sources"
+ * attribute of the Interpreter class), and each function refers to its declaration by number.
+ * A snapshot is made of a header ("BLEACHSNAP" and a version), the sources, the amount of declarations and the
+ * global environment (see the SnapshotTag enum).
+ *
+ * The same encoding is used by the "std::serial" native functions to serialize a single value (see the 
+ * "writeData" method). In that case, the writer is "portable": Classes are stored by name (and looked up among 
+ * the global variables when the value is loaded), and functions cannot be stored, since the value may be loaded
+ * by another program.
+ *
+ * @note: Values that only exist while a program runs (the methods of lists and strings that have been stored
+ * inside variables) cannot be stored. Trying to do so causes a runtime error.
+**/
+class SnapshotWriter{
+  private:
+    Interpreter& interpreter;
+    const Token& location; // Token used to report runtime errors.
+    const bool portable; // Whether classes are stored by name and functions are rejected (see the "writeData" method).
+    std::string buffer;
+    std::unordered_map<const void*, std::uint32_t> references; // Maps the address of each stored object to its number.
+    unsigned int depth = 0; // How many values and environments are being stored, one inside the other.
+
+    /**
+     * @struct Nesting
+     *
+     * @brief Counts a value or environment that is being stored for as long as it's being stored, and rejects
+     * it if it's nested too deeply (see the "maxSnapshotDepth" constant). It mirrors the Nesting struct of the
+     * SnapshotReader class, so every value that can be stored can also be rebuilt.
+    **/
+    struct Nesting{
+      SnapshotWriter& writer;
+
+      Nesting(SnapshotWriter& writer);
+
+      ~Nesting(){
+        writer.depth--;
+      }
+    };
+
+    void writeByte(std::uint8_t byte);
+    void writeInteger(std::uint32_t integer);
+    void writeString(const std::string& string);
+    bool writeReference(const void* address);
+    void writeEnvironment(const std::shared_ptr<Environment>& environment);
+    void writeFunction(const std::shared_ptr<BleachFunction>& function);
+    void writeValue(const std::any& value);
+
+  public:
+    SnapshotWriter(Interpreter& interpreter, const Token& location, bool portable = false);
+    std::string write();
+    std::string writeData(const std::any& value);
+};
+
+/**
+ * @class SnapshotReader
+ *
+ * @brief Utility class that restores a snapshot (see the SnapshotWriter class) into a fresh instance of the
+ * Interpreter class.
+ *
+ * The SnapshotReader class is responsible for mapping a snapshot file into memory, resolving its sources again
+ * (without running them) to get the declarations of its functions back, and rebuilding every value stored
+ * inside it, directly from the mapped bytes. It also loads single values serialized by the "writeData" method of
+ * the SnapshotWriter class (see the "readData" method).
+**/
+class SnapshotReader{
+  private:
+    Interpreter& interpreter;
+    const char* current = nullptr;
+    const char* end = nullptr;
+    std::vector<std::any> references; // The rebuilt objects, in the order in which they were numbered.
+    std::vector<std::pair<std::any*, std::uint32_t>> pendingReferences; // Places that refer to a class that was still being rebuilt.
+    unsigned int depth = 0; // How many values and environments are being rebuilt, one inside the other.
+
+    /**
+     * @struct Nesting
+     *
+     * @brief Counts a value or environment that is being rebuilt for as long as it's being rebuilt, and rejects
+     * it if it's nested too deeply (see the "maxSnapshotDepth" constant).
+    **/
+    struct Nesting{
+      SnapshotReader& reader;
+
+      Nesting(SnapshotReader& reader)
+        : reader{reader}
+      {
+        if(++reader.depth > maxSnapshotDepth){
+          reader.depth--;
+          throw std::runtime_error{"The value is nested too deeply."};
+        }
+      }
+
+      ~Nesting(){
+        reader.depth--;
+      }
+    };
+
+    std::uint8_t readByte();
+    std::uint32_t readInteger();
+    std::uint32_t readCount();
+    std::string readString();
+    std::any readDeclaration(std::uint32_t number);
+    std::shared_ptr<Environment> readEnvironment();
+    std::shared_ptr<BleachFunction> readFunction();
+    std::shared_ptr<BleachClass> readClass();
+    void readValue(std::any& destination);
+
+  public:
+    SnapshotReader(Interpreter& interpreter);
+    bool restore(const std::string& filePath);
+    std::any readData(const char* begin, const char* end);
+};
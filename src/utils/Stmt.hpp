@@ -1,6 +1,7 @@
 #pragma once
 
 #include <any>
+#include <atomic>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -18,11 +19,38 @@ struct Expression; // Expression statement (Used in function and method calls).
 struct For; // For loop statement.
 struct Function; // Function statement (Used in function declarations).
 struct If;
+struct Import; // Import statement (Used to load native modules).
 struct Print;
 struct Return;
 struct Var; // Variable declaration statement.
 struct While;
 
+/**
+ * @enum StmtKind
+ * 
+ * @brief Tags each kind of statement node from the Bleach AST (Abstract Syntax Tree).
+ *
+ * Every statement node stores its own kind, so the Interpreter class can jump straight to the visit method of
+ * a node without going through the virtual "accept" method. The order of the enumerators must match the order
+ * of the dispatch table inside the "execute" method of the Interpreter class.
+ */
+enum class StmtKind{
+  BLOCK,
+  BREAK,
+  CLASS,
+  CONTINUE,
+  DOWHILE,
+  EXPRESSION,
+  FOR,
+  FUNCTION,
+  IF,
+  IMPORT,
+  PRINT,
+  RETURN,
+  VAR,
+  WHILE,
+};
+
 /**
  * @struct StmtVisitor
  * 
@@ -47,6 +75,7 @@ struct StmtVisitor{
   virtual std::any visitForStmt(std::shared_ptr<For> stmt) = 0;
   virtual std::any visitFunctionStmt(std::shared_ptr<Function> stmt) = 0;
   virtual std::any visitIfStmt(std::shared_ptr<If> stmt) = 0;
+  virtual std::any visitImportStmt(std::shared_ptr<Import> stmt) = 0;
   virtual std::any visitPrintStmt(std::shared_ptr<Print> stmt) = 0;
   virtual std::any visitReturnStmt(std::shared_ptr<Return> stmt) = 0;
   virtual std::any visitVarStmt(std::shared_ptr<Var> stmt) = 0;
@@ -63,9 +92,26 @@ struct StmtVisitor{
  * The Stmt struct defines an abstract struct that is responsible for working as the base struct from which all
  * structs that represent different types of statement AST nodes will derive from. This struct has only a pure
  * virtual method called "accept". This method will be overridden by the derived structs where each kind of
- * struct will have its own implementation for such method.
+ * struct will have its own implementation for such method. It also has an attribute called "kind", which tells
+ * which derived struct the node actually is.
+ * Finally, the "liveNodes" static attribute counts how many statement nodes are currently alive. It's reported
+ * by the ":mem" command of the REPL.
  */
 struct Stmt{
+  static inline std::atomic<long> liveNodes{0};
+
+  const StmtKind kind;
+
+  Stmt(StmtKind kind)
+    : kind{kind}
+  {
+    liveNodes++;
+  }
+
+  virtual ~Stmt(){
+    liveNodes--;
+  }
+
   virtual std::any accept(StmtVisitor& visitor) = 0;
   virtual std::string toString() = 0;
 };
@@ -80,9 +126,13 @@ struct Stmt{
  * and stores a (possibly empty) sequence of statements inside itself. 
  * Therefore, this struct has only one attribute, called "statements". This attribute is a list of statements
  * that represents the sequence of statements the block contains.
+ * It also has a "needsScope" attribute, which is set to false by the Resolver when the block does not declare any
+ * variable, function or class in its own scope. In that case, the interpreter does not create an environment
+ * for it.
  */
 struct Block : Stmt, public std::enable_shared_from_this<Block>{
   const std::vector<std::shared_ptr<Stmt>> statements;
+  bool needsScope = true; // Whether the block declares anything in its own scope. Set by the Resolver.
 
   /**
    * @brief Constructs a Block node of the Bleach AST (Abstract Syntax Tree). 
@@ -92,7 +142,7 @@ struct Block : Stmt, public std::enable_shared_from_this<Block>{
    * @param statements: The list of statements that this block statements has. Such list is possibly empty.
   **/
   Block(std::vector<std::shared_ptr<Stmt>> statements)
-    : statements{std::move(statements)}
+    : Stmt{StmtKind::BLOCK}, statements{std::move(statements)}
   {}
 
   std::any accept(StmtVisitor& visitor) override{
@@ -125,7 +175,7 @@ struct Break : Stmt, public std::enable_shared_from_this<Break>{
    * @param keyword: The token that represents the "break" keyword.
   **/
   Break(Token keyword)
-    : keyword{std::move(keyword)}
+    : Stmt{StmtKind::BREAK}, keyword{std::move(keyword)}
   {}
 
   std::any accept(StmtVisitor& visitor) override{
@@ -150,11 +200,17 @@ struct Break : Stmt, public std::enable_shared_from_this<Break>{
  * the name of the superclass (if any) from which the class that has just been declared inherits from. The third
  * one is "methods". It's just a list of function declaration statements that represents the methods that were
  * declared inside this class.
+ * It also has a "superExprs" attribute, which is filled by the Resolver with every super expression that shows
+ * up inside the methods of the class, so they can be resolved when the class is finalized. Finally, it has a
+ * "fieldIds" attribute, also filled by the Resolver, with the interned IDs of the fields that the "init" method
+ * of the class assigns to "self". They are used to compute the layout of the instances of the class.
  */
 struct Class : Stmt, public std::enable_shared_from_this<Class>{
   const Token name;
   const std::shared_ptr<Variable> superclass;
   const std::vector<std::shared_ptr<Function>> methods;
+  std::vector<std::shared_ptr<Super>> superExprs; // Super expressions that appear inside the methods of the class. Filled by the Resolver.
+  std::vector<int> fieldIds; // Fields assigned to "self" inside the "init" method of the class. Filled by the Resolver.
 
   /**
    * @brief Constructs a Class node of the Bleach AST (Abstract Syntax Tree). 
@@ -167,7 +223,7 @@ struct Class : Stmt, public std::enable_shared_from_this<Class>{
    * @param methods: The list of methods that the declared class has declared inside itself.
   **/
   Class(Token name, std::shared_ptr<Variable> superclass, std::vector<std::shared_ptr<Function>> methods)
-    : name{std::move(name)}, superclass{std::move(superclass)}, methods{std::move(methods)}
+    : Stmt{StmtKind::CLASS}, name{std::move(name)}, superclass{std::move(superclass)}, methods{std::move(methods)}
   {}
 
   std::any accept(StmtVisitor& visitor) override{
@@ -200,7 +256,7 @@ struct Continue : Stmt, public std::enable_shared_from_this<Continue>{
    * @param keyword: The token that represents the "continue" keyword.
   **/
   Continue(Token keyword)
-    : keyword{std::move(keyword)}
+    : Stmt{StmtKind::CONTINUE}, keyword{std::move(keyword)}
   {}
 
   std::any accept(StmtVisitor& visitor) override{
@@ -227,10 +283,14 @@ struct Continue : Stmt, public std::enable_shared_from_this<Continue>{
  * @note: Remember that the statements present inside a do-while statement are always executed in its very 
  * first iteration because the evaluation of the expression present inside "condition" is made at the end of 
  * each iteration.
+ * It also has a "needsScope" attribute, which is set to false by the Resolver when the loop does not declare any
+ * variable, function or class in its own scope. In that case, the interpreter does not create an environment
+ * for it.
  */
 struct DoWhile : Stmt, public std::enable_shared_from_this<DoWhile>{
   const std::shared_ptr<Expr> condition;
   const std::vector<std::shared_ptr<Stmt>> body;
+  bool needsScope = true; // Whether the loop declares anything in its own scope. Set by the Resolver.
 
   /**
    * @brief Constructs a DoWhile node of the Bleach AST (Abstract Syntax Tree). 
@@ -247,7 +307,7 @@ struct DoWhile : Stmt, public std::enable_shared_from_this<DoWhile>{
    * always evaluated at the end of each iteration. 
   **/
   DoWhile(std::shared_ptr<Expr> condition, std::vector<std::shared_ptr<Stmt>> body)
-    : condition{std::move(condition)}, body{std::move(body)}
+    : Stmt{StmtKind::DOWHILE}, condition{std::move(condition)}, body{std::move(body)}
   {}
 
   std::any accept(StmtVisitor& visitor) override{
@@ -272,7 +332,7 @@ struct DoWhile : Stmt, public std::enable_shared_from_this<DoWhile>{
  * method call followed by a ";", you are looking at an expression statement.
  */
 struct Expression : Stmt, public std::enable_shared_from_this<Expression>{
-  const std::shared_ptr<Expr> expression;
+  std::shared_ptr<Expr> expression;
 
   /**
    * @brief Constructs a Expression node of the Bleach AST (Abstract Syntax Tree). 
@@ -283,7 +343,7 @@ struct Expression : Stmt, public std::enable_shared_from_this<Expression>{
    * @param expression: The expression that is wrapped inside the expression statement.
   **/
   Expression(std::shared_ptr<Expr> expression)
-    : expression{std::move(expression)}
+    : Stmt{StmtKind::EXPRESSION}, expression{std::move(expression)}
   {}
 
   std::any accept(StmtVisitor& visitor) override{
@@ -311,12 +371,16 @@ struct Expression : Stmt, public std::enable_shared_from_this<Expression>{
  * "increment". It's an expression that will be evaluated at the end of each iteration of a for loop. The fourth
  * one is called "body". It's the list of statements that will be executed while the "condition" expression
  * evaluates to true.
+ * It also has a "needsScope" attribute, which is set to false by the Resolver when the loop does not declare any
+ * variable, function or class in its own scope. In that case, the interpreter does not create an environment
+ * for it.
  */
 struct For : Stmt, public std::enable_shared_from_this<For>{
   const std::shared_ptr<Stmt> initializer;
   const std::shared_ptr<Expr> condition;
   const std::shared_ptr<Expr> increment;
   const std::vector<std::shared_ptr<Stmt>> body;
+  bool needsScope = true; // Whether the loop declares anything in its own scope. Set by the Resolver.
 
   /**
    * @brief Constructs a For node of the Bleach AST (Abstract Syntax Tree). 
@@ -333,7 +397,7 @@ struct For : Stmt, public std::enable_shared_from_this<For>{
    * evaluation of the expression stored inside the "condition" attribute.
   **/
   For(std::shared_ptr<Stmt> initializer, std::shared_ptr<Expr> condition, std::shared_ptr<Expr> increment, std::vector<std::shared_ptr<Stmt>> body)
-    : initializer{std::move(initializer)}, condition{std::move(condition)}, increment{std::move(increment)}, body{std::move(body)}
+    : Stmt{StmtKind::FOR}, initializer{std::move(initializer)}, condition{std::move(condition)}, increment{std::move(increment)}, body{std::move(body)}
   {}
 
   std::any accept(StmtVisitor& visitor) override{
@@ -358,11 +422,19 @@ struct For : Stmt, public std::enable_shared_from_this<For>{
  * function. The second one is called "parameters". It is a list of tokens where each token represents the name
  * of a parameter from the declared function. The third one is called "body". It's a list of statements that 
  * will be executed when the declared function is called during runtime.
+ * It also has a "tailReturn" attribute, which is set by the Resolver when the only return statement of the 
+ * function is the last statement of its body. The value of such functions is computed without throwing an
+ * instance of the BleachReturn struct.
+ * Finally, the "declarationId" attribute numbers the function among every function and lambda function resolved
+ * by the same instance of the Interpreter class. Snapshots refer to the function by this number.
  */
 struct Function : Stmt, public std::enable_shared_from_this<Function>{
   const Token name; // The name of the function. It's has a TokenType::IDENTIFIER as its type attribute.
   const std::vector<Token> parameters; // As above, the parameters are all tokens that have TokenType::IDENTIFIER as their type attribute.
   const std::vector<std::shared_ptr<Stmt>> body; // The list of statements that make the body of the function.
+  bool tailReturn = false; // Whether the only return statement of the function is the last statement of its body. Set by the Resolver.
+  int declarationId = -1; // The number of the declaration (see the "registerDeclaration" method of the Interpreter class). Set by the Resolver.
+  bool pure = false; // Whether the body of the function has no side effects of its own. Set by the Resolver (see its "resolveFunction" method).
 
   /**
    * @brief Constructs a Function node of the Bleach AST (Abstract Syntax Tree). 
@@ -375,7 +447,7 @@ struct Function : Stmt, public std::enable_shared_from_this<Function>{
    * @param body: The list of statements that will be executed once the function is called during runtime.
   **/
   Function(Token name, std::vector<Token> parameters, std::vector<std::shared_ptr<Stmt>> body)
-    : name{std::move(name)}, parameters{std::move(parameters)}, body{std::move(body)}
+    : Stmt{StmtKind::FUNCTION}, name{std::move(name)}, parameters{std::move(parameters)}, body{std::move(body)}
   {}
 
   std::any accept(StmtVisitor& visitor) override{
@@ -408,7 +480,7 @@ struct Function : Stmt, public std::enable_shared_from_this<Function>{
  * statements is executed, the flow of the code "gets out" from the if statement.
  */
 struct If : Stmt, public std::enable_shared_from_this<If>{
-  const std::shared_ptr<Expr> ifCondition;
+  std::shared_ptr<Expr> ifCondition;
   const std::shared_ptr<Stmt> ifBranch;
   const std::vector<std::shared_ptr<Expr>> elifConditions;
   const std::vector<std::shared_ptr<Stmt>> elifBranches;
@@ -434,7 +506,7 @@ struct If : Stmt, public std::enable_shared_from_this<If>{
    * in an if statement.
   **/
   If(std::shared_ptr<Expr> ifCondition, std::shared_ptr<Stmt> ifBranch, std::vector<std::shared_ptr<Expr>> elifConditions, std::vector<std::shared_ptr<Stmt>> elifBranches, std::shared_ptr<Stmt> elseBranch)
-    : ifCondition{std::move(ifCondition)}, ifBranch{std::move(ifBranch)}, elifConditions{std::move(elifConditions)}, elifBranches{std::move(elifBranches)}, elseBranch{std::move(elseBranch)}
+    : Stmt{StmtKind::IF}, ifCondition{std::move(ifCondition)}, ifBranch{std::move(ifBranch)}, elifConditions{std::move(elifConditions)}, elifBranches{std::move(elifBranches)}, elseBranch{std::move(elseBranch)}
   {}
 
   std::any accept(StmtVisitor& visitor) override{
@@ -446,6 +518,44 @@ struct If : Stmt, public std::enable_shared_from_this<If>{
   }
 };
 
+/**
+ * @struct Import
+ * 
+ * @brief Defines a struct to represent an import statement node from the AST of the Bleach language.
+ *
+ * The Import struct defines a struct to represent an import statement node from the AST (Abstract Syntax Tree)
+ * of the Bleach language. An import statement ("import native "libfoo.so";") loads a native module: A shared
+ * library written in C++ against the "extension/Extension.hpp" header, whose native functions are defined inside
+ * the global environment once the statement is executed.
+ * This struct has two attributes: The first one is called "keyword". It is a token that represents the "import"
+ * keyword. The second one is called "path". It is a token of TokenType::STRING type whose literal is the path of
+ * the shared library.
+ */
+struct Import : Stmt, public std::enable_shared_from_this<Import>{
+  const Token keyword;
+  const Token path;
+
+  /**
+   * @brief Constructs an Import node of the Bleach AST (Abstract Syntax Tree). 
+   *
+   * This constructor initializes an Import object with the two attributes that were mentioned above.
+   *
+   * @param keyword: The token that represents the "import" keyword.
+   * @param path: The token that represents the path of the native module.
+  **/
+  Import(Token keyword, Token path)
+    : Stmt{StmtKind::IMPORT}, keyword{std::move(keyword)}, path{std::move(path)}
+  {}
+
+  std::any accept(StmtVisitor& visitor) override{
+    return visitor.visitImportStmt(shared_from_this());
+  }
+
+  std::string toString() override{
+    return "import statement";
+  }
+};
+
 /**
  * @struct Print
  * 
@@ -457,7 +567,7 @@ struct If : Stmt, public std::enable_shared_from_this<If>{
  * then displayed to the user through the console/terminal.
  */
 struct Print : Stmt, public std::enable_shared_from_this<Print>{
-  const std::shared_ptr<Expr> expression;
+  std::shared_ptr<Expr> expression;
 
   /**
    * @brief Constructs a Print node of the Bleach AST (Abstract Syntax Tree). 
@@ -468,7 +578,7 @@ struct Print : Stmt, public std::enable_shared_from_this<Print>{
    * runtime.
   **/
   Print(std::shared_ptr<Expr> expression)
-    : expression{std::move(expression)}
+    : Stmt{StmtKind::PRINT}, expression{std::move(expression)}
   {}
 
   std::any accept(StmtVisitor& visitor) override{
@@ -496,7 +606,7 @@ struct Print : Stmt, public std::enable_shared_from_this<Print>{
  */
 struct Return : Stmt, public std::enable_shared_from_this<Return>{
   const Token keyword;
-  const std::shared_ptr<Expr> value;
+  std::shared_ptr<Expr> value;
 
   /**
    * @brief Constructs a Return node of the Bleach AST (Abstract Syntax Tree). 
@@ -509,7 +619,7 @@ struct Return : Stmt, public std::enable_shared_from_this<Return>{
    * If nullptr is provided as its value, then the return statement will return nil as its default value.
   **/
   Return(Token keyword, std::shared_ptr<Expr> value)
-    : keyword{std::move(keyword)}, value{std::move(value)}
+    : Stmt{StmtKind::RETURN}, keyword{std::move(keyword)}, value{std::move(value)}
   {}
 
   std::any accept(StmtVisitor& visitor) override{
@@ -536,7 +646,7 @@ struct Return : Stmt, public std::enable_shared_from_this<Return>{
  */
 struct Var : Stmt, public std::enable_shared_from_this<Var>{
   const Token name;
-  const std::shared_ptr<Expr> initializer;
+  std::shared_ptr<Expr> initializer;
 
   /**
    * @brief Constructs a Var node of the Bleach AST (Abstract Syntax Tree). 
@@ -549,7 +659,7 @@ struct Var : Stmt, public std::enable_shared_from_this<Var>{
    * value.
   **/
   Var(Token name, std::shared_ptr<Expr> initializer)
-    : name{std::move(name)}, initializer{std::move(initializer)}
+    : Stmt{StmtKind::VAR}, name{std::move(name)}, initializer{std::move(initializer)}
   {}
 
   std::any accept(StmtVisitor& visitor) override{
@@ -572,10 +682,14 @@ struct Var : Stmt, public std::enable_shared_from_this<Var>{
  * value evaluated during runtime determines for how long the statements inside the while body will be executed.
  * The second one is called "body". It is a list of statements that will be executed while the "condition"
  * expression evaluates to true during runtime.
+ * It also has a "needsScope" attribute, which is set to false by the Resolver when the loop does not declare any
+ * variable, function or class in its own scope. In that case, the interpreter does not create an environment
+ * for it.
  */
 struct While : Stmt, public std::enable_shared_from_this<While>{
   const std::shared_ptr<Expr> condition;
   const std::vector<std::shared_ptr<Stmt>> body;
+  bool needsScope = true; // Whether the loop declares anything in its own scope. Set by the Resolver.
 
   /**
    * @brief Constructs a While node of the Bleach AST (Abstract Syntax Tree). 
@@ -590,7 +704,7 @@ struct While : Stmt, public std::enable_shared_from_this<While>{
    * evaluation of the expression stored inside the "condition" attribute.
   **/
   While(std::shared_ptr<Expr> condition, std::vector<std::shared_ptr<Stmt>> body)
-    : condition{std::move(condition)}, body{std::move(body)}
+    : Stmt{StmtKind::WHILE}, condition{std::move(condition)}, body{std::move(body)}
   {}
 
   std::any accept(StmtVisitor& visitor) override{
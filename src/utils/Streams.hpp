@@ -0,0 +1,17 @@
+#pragma once
+
+#include <iostream>
+
+
+/**
+ * @brief The streams that the BLEACH Interpreter writes to.
+ *
+ * Everything that a Bleach program prints (through the "print" statement or the "std::io::print" native 
+ * function) is written to "outputStream", and every error reported by the BLEACH Interpreter is written to 
+ * "errorStream". By default, they point to the standard output and to the standard error of the process.
+ *
+ * @note: Both variables are thread local. This allows the "--batch" mode to run several Bleach programs at the
+ * same time (one per thread), each one of them with its output captured in its own buffer.
+**/
+inline thread_local std::ostream* outputStream = &std::cout; /**< Variable that points to the stream where the output of a Bleach program is written. */
+inline thread_local std::ostream* errorStream = &std::cerr; /**< Variable that points to the stream where the errors of a Bleach program are written. */
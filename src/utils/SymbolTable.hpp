@@ -0,0 +1,72 @@
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+/**
+ * @class SymbolTable
+ *
+ * @brief Utility class that interns the names of properties (methods and fields), so each name can be
+ * represented by a small integer ID.
+ *
+ * The SymbolTable class is responsible for mapping every property name that shows up inside a Bleach program to
+ * a unique integer ID. The names are interned only once, when the AST nodes that refer to them are created or
+ * when a class is finalized. After that, the runtime can look up methods and fields by comparing integers
+ * instead of strings.
+ *
+ * @note: There's only one table per process, and the IDs stay valid for the whole execution of the BLEACH
+ * Interpreter. Interning is guarded by a mutex, since ASTs can be built by more than one thread.
+**/
+class SymbolTable{
+  private:
+    std::mutex mutex; /**< Variable that guards the two containers below. */
+    std::unordered_map<std::string, int> ids; /**< Variable that maps each interned name to its ID. */
+    std::vector<std::string> names; /**< Variable that maps each ID back to its name. */
+
+    static SymbolTable& table(){
+      static SymbolTable symbolTable;
+
+      return symbolTable;
+    }
+
+  public:
+    /**
+     * @brief Returns the ID of the received name, interning such name if it has never been seen before.
+     *
+     * @param name: The name of a property (method or field).
+     *
+     * @return An integer that is the unique ID of the received name.
+    **/
+    static int intern(const std::string& name){
+      SymbolTable& symbolTable = table();
+      std::lock_guard<std::mutex> lock{symbolTable.mutex};
+
+      auto elem = symbolTable.ids.find(name);
+      if(elem != symbolTable.ids.end()){
+        return elem->second;
+      }
+
+      int id = symbolTable.names.size();
+      symbolTable.ids.emplace(name, id);
+      symbolTable.names.push_back(name);
+
+      return id;
+    }
+
+    /**
+     * @brief Returns the name that is associated to the received ID.
+     *
+     * @param id: The ID of a name that has already been interned.
+     *
+     * @return The name associated to the received ID.
+    **/
+    static std::string name(int id){
+      SymbolTable& symbolTable = table();
+      std::lock_guard<std::mutex> lock{symbolTable.mutex};
+
+      return symbolTable.names[id];
+    }
+};
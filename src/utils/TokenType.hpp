@@ -28,7 +28,7 @@ enum TokenType{
 
   // Keywords.
   AND, BREAK, CLASS, CONTINUE, DO, ELIF, ELSE,
-  FALSE, FOR, FUNCTION, IF, INHERITS, LAMBDA, LET, METHOD,
+  FALSE, FOR, FUNCTION, IF, IMPORT, INHERITS, LAMBDA, LET, METHOD,
   NIL, OR, PRINT, RETURN, SELF, SUPER, TRUE, WHILE,
 
   // File End.
@@ -58,7 +58,7 @@ std::string toString(TokenType type){
     "LESS", "LESS_EQUAL",
     "IDENTIFIER", "NUMBER", "STRING",
     "AND", "BREAK", "CLASS", "CONTINUE", "DO", "ELIF", "ELSE",
-    "FALSE", "FOR", "FUNCTION", "IF", "INHERITS", "LAMBDA", "LET", "METHOD",
+    "FALSE", "FOR", "FUNCTION", "IF", "IMPORT", "INHERITS", "LAMBDA", "LET", "METHOD",
     "NIL", "OR", "PRINT", "RETURN", "SELF", "SUPER", "TRUE", "WHILE",
     "FILE_END"
   };
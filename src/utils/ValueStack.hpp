@@ -0,0 +1,131 @@
+#pragma once
+
+#include <any>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+
+/**
+ * @struct ArgumentSpan
+ *
+ * @brief Non-owning view of the arguments of a call. The values themselves live inside the ValueStack of the
+ * interpreter, and the span is only valid while the call that has pushed them is running.
+ *
+ * Callees may move values out of the span (e.g. when binding them to parameters), since the arguments are
+ * thrown away as soon as the call returns.
+**/
+struct ArgumentSpan{
+  std::any* values = nullptr;
+  std::size_t count = 0;
+
+  std::size_t size() const{
+    return count;
+  }
+
+  bool empty() const{
+    return count == 0;
+  }
+
+  std::any& operator[](std::size_t index) const{
+    return values[index];
+  }
+
+  std::any* begin() const{
+    return values;
+  }
+
+  std::any* end() const{
+    return values + count;
+  }
+};
+
+/**
+ * @class ValueStack
+ *
+ * @brief Stack, owned by the interpreter, onto which the arguments of every call are evaluated.
+ *
+ * The ValueStack class hands out contiguous ranges of values (see the Frame class) in a LIFO order. It's made of
+ * chunks that are never reallocated, so a range stays valid while the calls nested inside it push and pop their
+ * own arguments. Chunks are kept after use, so, once the stack is warm, a call does not allocate any memory to
+ * hold its arguments.
+**/
+class ValueStack{
+  private:
+    static constexpr std::size_t chunkSize = 4096; // The number of values of each chunk (unless a single call needs more).
+
+    std::vector<std::unique_ptr<std::any[]>> chunks;
+    std::vector<std::size_t> capacities; // The number of values of each chunk.
+    std::size_t current = 0; // The chunk that holds the top of the stack.
+    std::size_t top = 0; // The first free value inside the current chunk.
+
+  public:
+    /**
+     * @class Frame
+     *
+     * @brief The range of values that holds the arguments of a single call. The values are released (and the
+     * top of the stack is restored) when the frame is destroyed, even if the call throws.
+    **/
+    class Frame{
+      private:
+        ValueStack& stack;
+        const std::size_t savedCurrent;
+        const std::size_t savedTop;
+        std::any* values;
+        const std::size_t count;
+
+      public:
+        Frame(ValueStack& stack, std::size_t count)
+          : stack{stack}, savedCurrent{stack.current}, savedTop{stack.top}, values{stack.reserve(count)}, count{count}
+        {}
+
+        Frame(const Frame&) = delete;
+        Frame& operator=(const Frame&) = delete;
+
+        ~Frame(){
+          for(std::size_t i = 0; i < count; i++){
+            values[i].reset();
+          }
+          stack.current = savedCurrent;
+          stack.top = savedTop;
+        }
+
+        std::any& operator[](std::size_t index){
+          return values[index];
+        }
+
+        ArgumentSpan arguments() const{
+          return ArgumentSpan{values, count};
+        }
+    };
+
+  private:
+    /**
+     * @brief Reserves "count" contiguous values on top of the stack. Moves on to the next chunk (creating it if
+     * needed) when the current one does not have enough room.
+     *
+     * @param count: The number of values.
+     *
+     * @return A pointer to the first reserved value.
+    **/
+    std::any* reserve(std::size_t count){
+      if(chunks.empty() || top + count > capacities[current]){
+        std::size_t next = chunks.empty() ? 0 : current + 1;
+        if(next == chunks.size()){
+          chunks.emplace_back();
+          capacities.push_back(0);
+        }
+        if(capacities[next] < count){ // The chunks after the current one are not in use, so they can be replaced.
+          capacities[next] = count > chunkSize ? count : chunkSize;
+          chunks[next] = std::make_unique<std::any[]>(capacities[next]);
+        }
+        current = next;
+        top = 0;
+      }
+
+      std::any* values = chunks[current].get() + top;
+      top += count;
+
+      return values;
+    }
+};
@@ -0,0 +1,19 @@
+// Native module used by the test suite to check whether a native module whose initialization throws is reported
+// as a runtime error. It registers a native function before throwing, so that function must be removed again.
+
+#include <exception>
+
+#include "extension/Extension.hpp"
+
+
+class ModuleError : public std::exception{ // Defined by the module, so its message must be copied before the module is unloaded.
+  public:
+    const char* what() const noexcept override{
+      return "the module could not allocate its resources";
+    }
+};
+
+BLEACH_EXTENSION(registrar){
+  registrar.defineNative(bindNative<double(double)>("failing::twice", [](double x){ return 2 * x; }));
+  throw ModuleError{};
+}
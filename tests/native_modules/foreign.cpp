@@ -0,0 +1,41 @@
+// Plain shared library (not a native module) used by the test suite to check the foreign function interface
+// (see the "std::ffi" namespace). It is built along with the native modules, so the test does not depend on the
+// names of the C libraries of the platform.
+
+#include <cmath>
+#include <cstring>
+
+
+extern "C" double hypotenuse(double x, double y){
+  return std::sqrt(x * x + y * y);
+}
+
+extern "C" int negate(int value){
+  return -value;
+}
+
+extern "C" long widen(long value){
+  return value * 2;
+}
+
+extern "C" long length(const char* text){
+  return static_cast<long>(std::strlen(text));
+}
+
+extern "C" const char* lookup(const char* key){
+  return std::strcmp(key, "name") == 0 ? "Bleach" : nullptr;
+}
+
+extern "C" void scale(double* values, int count, double factor){ // Writes its results into the received array.
+  for(int i = 0; i < count; i++){
+    values[i] *= factor;
+  }
+}
+
+extern "C" void prefixSums(const double* values, double* sums, int count){ // Reads one array and writes another.
+  double total = 0;
+  for(int i = 0; i < count; i++){
+    total += values[i];
+    sums[i] = total;
+  }
+}
@@ -0,0 +1,6 @@
+// Shared library used by the test suite to check whether importing a shared library that has not been declared
+// with the BLEACH_EXTENSION macro (it has no "bleachExtensionInit" function) is reported as a runtime error.
+
+extern "C" int bleachExtensionVersion(){
+  return 1;
+}
@@ -0,0 +1,12 @@
+// Native module used by the test suite to check whether a native module can be imported and its native functions
+// can be called (see the "import native" statement).
+
+#include <cmath>
+
+#include "extension/Extension.hpp"
+
+
+BLEACH_EXTENSION(registrar){
+  registrar.defineNative(bindNative<double(double, double)>("vec::hypot", [](double x, double y){ return std::hypot(x, y); }));
+  registrar.defineNative(bindNative<double(double, double, double, double)>("vec::dot", [](double x1, double y1, double x2, double y2){ return x1 * x2 + y1 * y2; }));
+}